@@ -5,11 +5,22 @@
 
 #include <iostream>
 #include <climits>
+#include <fstream>
+#include <limits>
 #include <map>
+#include <memory>
 #include <sstream>
+#include <utility>
 #include <vector>
 
+#include "contraction.h"
+#include "dynamictree.h"
+#include "edgefile.h"
 #include "graph.h"
+#include "graphgen.h"
+#include "labelpool.h"
+#include "landmarks.h"
+#include "querypool.h"
 
 ////////////////////////////////////////////////////////////////////////////////
 // This is 80 characters - Keep all lines under 80 characters                 //
@@ -189,10 +200,1209 @@ void testGraph2() {
 		<< "Djisktra O" << endl;
 }
 
+void testCsrGraph() {
+	cout << "testCsrGraph" << endl;
+	Graph g;
+	g.readFile("graph1.txt");
+	CsrGraph csr = g.freeze();
+	cout << isOK(csr.getNumVertices(), 10) << "10 vertices" << endl;
+	cout << isOK(csr.getNumEdges(), 9) << "9 edges" << endl;
+	cout << isOK(csr.getEdgeWeight("A", "H"), 3) << "A->H weight" << endl;
+	cout << isOK(csr.getEdgeWeight("H", "A"), INT_MAX) << "no H->A" << endl;
+
+	graphOut.str("");
+	csr.depthFirstTraversal("A", graphVisitor);
+	cout << isOK(graphOut.str(), "A B C D E F G H "s) << "DFS" << endl;
+
+	graphOut.str("");
+	csr.breadthFirstTraversal("A", graphVisitor);
+	cout << isOK(graphOut.str(), "A B H C G D E F "s) << "BFS" << endl;
+
+	csr.djikstraCostToAllVertices("A", weight, previous);
+	graphCostDisplay();
+	cout << isOK(graphOut.str(),
+		"B(1) C(2) via [B] "s +
+		"D(3) via [B C] E(4) via [B C D] "s +
+		"F(5) via [B C D E] " +
+		"G(4) via [H] "s +
+		"H(3) "s)
+		<< "Djisktra" << endl;
+}
+
+void testDjikstraAfterAdd() {
+	cout << "testDjikstraAfterAdd" << endl;
+	Graph g;
+	g.add("A", "B", 5);
+	g.djikstraCostToAllVertices("A", weight, previous);
+	graphCostDisplay();
+	cout << isOK(graphOut.str(), "B(5) "s) << "Djisktra" << endl;
+
+	// the new edges must be seen by the next query
+	g.add("A", "C", 1);
+	g.add("C", "B", 1);
+	g.djikstraCostToAllVertices("A", weight, previous);
+	graphCostDisplay();
+	cout << isOK(graphOut.str(), "B(2) via [C] C(1) "s)
+		<< "Djisktra after add" << endl;
+}
+
+// join a path into "A B C"
+string pathString(const vector<string>& path) {
+	string joined;
+	for (const string& label : path) {
+		joined += (joined.empty() ? "" : " ") + label;
+	}
+	return joined;
+}
+
+void testShortestPath() {
+	cout << "testShortestPath" << endl;
+	Graph g;
+	g.add("A", "B", 1);
+	g.add("A", "C", 4);
+	g.add("B", "C", 1);
+	g.add("C", "D", 1);
+	g.add("B", "D", 5);
+	g.add("E", "A", 1);
+	vector<string> path;
+
+	cout << isOK(g.shortestPath("A", "D", path), 3) << "A to D" << endl;
+	cout << isOK(pathString(path), "A B C D"s) << "A to D path" << endl;
+	cout << isOK(g.bidirectionalShortestPath("A", "D", path), 3)
+		<< "bidirectional A to D" << endl;
+	cout << isOK(pathString(path), "A B C D"s)
+		<< "bidirectional A to D path" << endl;
+
+	cout << isOK(g.shortestPath("D", "A", path), INT_MAX)
+		<< "D to A unreachable" << endl;
+	cout << isOK(g.bidirectionalShortestPath("A", "E", path), INT_MAX)
+		<< "bidirectional A to E unreachable" << endl;
+	cout << isOK(g.bidirectionalShortestPath("A", "A", path), 0)
+		<< "bidirectional A to A" << endl;
+	cout << isOK(g.shortestPath("A", "X", path), INT_MAX)
+		<< "missing vertex" << endl;
+}
+
+// write contents to filename for the file reading tests
+void writeFile(const string& filename, const string& contents) {
+	ofstream fout(filename);
+	fout << contents;
+}
+
+void testReadFileErrors() {
+	cout << "testReadFileErrors" << endl;
+	Graph g;
+	cout << isOK(g.readFile("no_such_graph.txt"), false)
+		<< "missing file" << endl;
+
+	writeFile("graph_bad_weight.txt", "2\nA B 1\nB C x\n");
+	cout << isOK(g.readFile("graph_bad_weight.txt"), false)
+		<< "bad weight" << endl;
+	cout << isOK(g.getNumVertices(), 0) << "nothing added" << endl;
+
+	writeFile("graph_short.txt", "3\nA B 1\nB C 2\n");
+	cout << isOK(g.readFile("graph_short.txt"), false)
+		<< "too few edges" << endl;
+
+	writeFile("graph_crlf.txt", "2\r\nA B 1\r\n\r\nB C 2\r\n");
+	cout << isOK(g.readFile("graph_crlf.txt"), true)
+		<< "CRLF and blank lines" << endl;
+	cout << isOK(g.getNumEdges(), 2) << "2 edges" << endl;
+	cout << isOK(g.getEdgeWeight("B", "C"), 2) << "B->C weight" << endl;
+}
+
+void testParallelReadFile() {
+	cout << "testParallelReadFile" << endl;
+
+	// big enough to be split between threads, the lines after the
+	// counted edges must be ignored like they are by one thread
+	ostringstream contents;
+	int numEdges = 200000;
+	contents << numEdges << "\n";
+	for (int i = 0; i < numEdges; ++i) {
+		contents << "v" << i % 7919 << " v" << (i * 31) % 7907
+			<< " " << i % 10 << "\n";
+	}
+	contents << "extra1 extra2 1\nnot an edge\n";
+	writeFile("graph_large.txt", contents.str());
+
+	EdgeFile serial;
+	EdgeFile parallel;
+	cout << isOK(serial.load("graph_large.txt", 1), true)
+		<< "one thread" << endl;
+	cout << isOK(parallel.load("graph_large.txt", 4), true)
+		<< "four threads" << endl;
+	cout << isOK(parallel.getLabels() == serial.getLabels(), true)
+		<< "same labels" << endl;
+
+	bool sameEdges = parallel.getEdges().size() == serial.getEdges().size();
+	for (size_t i = 0; sameEdges && i < serial.getEdges().size(); ++i) {
+		const EdgeFile::Record& a = serial.getEdges()[i];
+		const EdgeFile::Record& b = parallel.getEdges()[i];
+		sameEdges = a.from == b.from && a.to == b.to && a.weight == b.weight;
+	}
+	cout << isOK(sameEdges, true) << "same edges" << endl;
+
+	Graph g;
+	cout << isOK(g.readFile("graph_large.txt", 0), true)
+		<< "Graph::readFile all cores" << endl;
+	cout << isOK(g.getNumEdges(), numEdges) << "edge count" << endl;
+}
+
+void testBinarySnapshot() {
+	cout << "testBinarySnapshot" << endl;
+	Graph g;
+	g.readFile("graph1.txt");
+	cout << isOK(g.saveBinary("graph1.bin"), true) << "save" << endl;
+
+	CsrGraph csr;
+	cout << isOK(csr.openBinary("graph1.txt"), false)
+		<< "text file rejected" << endl;
+	cout << isOK(csr.openBinary("graph1.bin"), true) << "open" << endl;
+	cout << isOK(csr.getNumVertices(), 10) << "10 vertices" << endl;
+	cout << isOK(csr.getNumEdges(), 9) << "9 edges" << endl;
+
+	graphOut.str("");
+	csr.depthFirstTraversal("A", graphVisitor);
+	cout << isOK(graphOut.str(), "A B C D E F G H "s) << "DFS" << endl;
+
+	graphOut.str("");
+	csr.breadthFirstTraversal("A", graphVisitor);
+	cout << isOK(graphOut.str(), "A B H C G D E F "s) << "BFS" << endl;
+
+	csr.djikstraCostToAllVertices("A", weight, previous);
+	graphCostDisplay();
+	cout << isOK(graphOut.str(),
+		"B(1) C(2) via [B] "s +
+		"D(3) via [B C] E(4) via [B C D] "s +
+		"F(5) via [B C D E] " +
+		"G(4) via [H] "s +
+		"H(3) "s)
+		<< "Djisktra" << endl;
+
+	// the sources array of 9 edges takes the 40 bytes before the 40 of
+	// the last array, point the first source past the vertices
+	{
+		fstream damaged("graph1.bin", ios::in | ios::out | ios::binary);
+		damaged.seekp(-80, ios::end);
+		uint32_t pastEnd = 1000;
+		damaged.write(reinterpret_cast<const char*>(&pastEnd),
+			sizeof(pastEnd));
+	}
+	CsrGraph checked;
+	cout << isOK(checked.openBinary("graph1.bin"), false)
+		<< "damaged file rejected" << endl;
+	cout << isOK(checked.openBinary("graph1.bin", false), true)
+		<< "trusted file not checked" << endl;
+}
+
+void testSearchWorkspace() {
+	cout << "testSearchWorkspace" << endl;
+	Graph graph;
+	graph.readFile("graph2.txt");
+	const Graph& g = graph;
+
+	// one workspace reused by several queries on a const graph
+	SearchWorkspace workspace;
+	graphOut.str("");
+	g.depthFirstTraversal("A", graphVisitor, workspace);
+	cout << isOK(graphOut.str(), "A B E F J C G K L D H M I N "s)
+		<< "DFS from A" << endl;
+
+	graphOut.str("");
+	g.depthFirstTraversal("O", graphVisitor, workspace);
+	cout << isOK(graphOut.str(), "O P R S T U Q "s)
+		<< "DFS from O" << endl;
+
+	graphOut.str("");
+	g.breadthFirstTraversal("D", graphVisitor, workspace);
+	cout << isOK(graphOut.str(), "D H I M N "s)
+		<< "BFS from D" << endl;
+
+	vector<string> path;
+	cout << isOK(g.shortestPath("O", "U", path, workspace), 9)
+		<< "O to U" << endl;
+	cout << isOK(g.bidirectionalShortestPath("O", "T", path, workspace), 8)
+		<< "bidirectional O to T" << endl;
+	cout << isOK(g.shortestPath("U", "O", path, workspace), INT_MAX)
+		<< "U to O unreachable" << endl;
+}
+
+void testQueryPool() {
+	cout << "testQueryPool" << endl;
+	Graph g;
+	g.readFile("graph2.txt");
+	CsrGraph csr = g.freeze();
+
+	// every pair of vertices, both kinds of query
+	vector<Query> queries;
+	for (int s = 0; s < csr.getNumVertices(); ++s) {
+		for (int t = 0; t < csr.getNumVertices(); ++t) {
+			Query query = { Query::SHORTEST_PATH, static_cast<uint32_t>(s),
+				static_cast<uint32_t>(t), 0, false };
+			queries.push_back(query);
+			query.kind = Query::REACHABLE;
+			queries.push_back(query);
+		}
+	}
+
+	QueryPool pool(4);
+	cout << isOK(pool.getNumThreads(), 4u) << "4 threads" << endl;
+	pool.run(csr, queries);
+
+	bool same = true;
+	SearchWorkspace workspace;
+	vector<uint32_t> path;
+	for (const Query& query : queries) {
+		int cost = csr.shortestPath(query.source, query.target, path,
+			workspace);
+		same = same && query.reachable == (cost != INT_MAX);
+		if (query.kind == Query::SHORTEST_PATH) {
+			same = same && query.cost == cost;
+		}
+	}
+	cout << isOK(same, true) << "same answers as one thread" << endl;
+
+	// a second batch on the same pool
+	pool.run(csr, queries);
+	cout << isOK(queries[1].reachable, true) << "second batch" << endl;
+
+	// a pool for float weights
+	BasicGraph<float, uint32_t> latency;
+	latency.add("A", "B", 0.5f);
+	latency.add("B", "C", 0.25f);
+	BasicCsrGraph<float, uint32_t> floatCsr = latency.freeze();
+	vector<BasicQuery<float, uint32_t>> floatQueries(2);
+	floatQueries[0].kind = BasicQuery<float, uint32_t>::SHORTEST_PATH;
+	floatQueries[0].source = floatCsr.findVertex("A");
+	floatQueries[0].target = floatCsr.findVertex("C");
+	floatQueries[1] = floatQueries[0];
+	swap(floatQueries[1].source, floatQueries[1].target);
+	BasicQueryPool<float, uint32_t> floatPool(2);
+	floatPool.run(floatCsr, floatQueries);
+	cout << isOK(floatQueries[0].cost, 0.75f) << "float cost" << endl;
+	cout << isOK(floatQueries[1].reachable, false) << "float unreachable"
+		<< endl;
+}
+
+void testVertexNeighbors() {
+	cout << "testVertexNeighbors" << endl;
+	Vertex v("A");
+	v.connect("C", 3);
+	v.connect("B", 2);
+	v.connect("D");
+	cout << isOK(v.getNumberOfNeighbors(), 3) << "3 neighbors" << endl;
+
+	ostringstream out;
+	for (Vertex::Neighbor neighbor : v.neighbors()) {
+		out << neighbor.label << neighbor.weight << " ";
+	}
+	cout << isOK(out.str(), "B2 C3 D0 "s) << "neighbors in order" << endl;
+
+	cout << isOK(v.disconnect("C"), true) << "disconnect C" << endl;
+	cout << isOK(v.disconnect("C"), false) << "C already gone" << endl;
+	cout << isOK(v.getNumberOfNeighbors(), 2) << "2 neighbors" << endl;
+}
+
+void testArenaGraph() {
+	cout << "testArenaGraph" << endl;
+	Graph heap;
+	Graph arena(Graph::ARENA);
+	heap.readFile("graph2.txt");
+	arena.readFile("graph2.txt");
+	arena.add("O", "A", 4);
+	heap.add("O", "A", 4);
+	cout << isOK(arena.getNumEdges(), heap.getNumEdges())
+		<< "same edges" << endl;
+	cout << isOK(arena.getEdgeWeight("O", "A"), 4) << "added O A" << endl;
+
+	graphOut.str("");
+	heap.depthFirstTraversal("O", graphVisitor);
+	string expected = graphOut.str();
+	graphOut.str("");
+	arena.depthFirstTraversal("O", graphVisitor);
+	cout << isOK(graphOut.str(), expected) << "same DFS from O" << endl;
+
+	graphOut.str("");
+	heap.breadthFirstTraversal("A", graphVisitor);
+	expected = graphOut.str();
+	graphOut.str("");
+	arena.breadthFirstTraversal("A", graphVisitor);
+	cout << isOK(graphOut.str(), expected) << "same BFS from A" << endl;
+
+	vector<string> path;
+	cout << isOK(arena.shortestPath("O", "N", path),
+		heap.shortestPath("O", "N", path)) << "same O to N" << endl;
+}
+
+void testLabelPool() {
+	cout << "testLabelPool" << endl;
+	LabelPool pool;
+	LabelPool::Label a = pool.intern("https://example.com/a");
+	LabelPool::Label b = pool.intern("https://example.com/b");
+	string copy = "https://example.com/a";
+	cout << isOK(pool.intern(copy), a) << "same label, same handle" << endl;
+	cout << isOK(a != b, true) << "different labels" << endl;
+	cout << isOK(pool.find("nope"), LabelPool::NO_LABEL) << "not found" << endl;
+	cout << isOK(string(pool.view(b)), "https://example.com/b"s)
+		<< "view" << endl;
+	cout << isOK(pool.size(), size_t(2)) << "2 labels" << endl;
+	cout << isOK(pool.getNumBytes(), size_t(42)) << "stored once" << endl;
+
+	// string_view arguments, no std::string built by the caller
+	Graph g;
+	string_view from = "A";
+	g.add(from, "B", 3);
+	g.add("B", string_view("C"), 4);
+	cout << isOK(g.getEdgeWeight(from, "B"), 3) << "A B" << endl;
+	cout << isOK(g.getNumVertices(), 3) << "3 vertices" << endl;
+	vector<string> path;
+	cout << isOK(g.shortestPath(from, "C", path), 7) << "A to C" << endl;
+}
+
+void testWeightTypes() {
+	cout << "testWeightTypes" << endl;
+	vector<string> path;
+
+	// narrow weights add up in a wider cost type
+	BasicGraph<uint16_t, uint16_t> road;
+	road.add("A", "B", 60000);
+	road.add("B", "C", 60000);
+	cout << isOK(road.shortestPath("A", "C", path), 120000u)
+		<< "uint16_t weights" << endl;
+	cout << isOK(road.getEdgeWeight("C", "A"), uint16_t(UINT16_MAX))
+		<< "uint16_t no edge" << endl;
+
+	BasicGraph<int64_t, uint32_t> haul;
+	haul.add("A", "B", 3000000000LL);
+	haul.add("B", "C", 3000000000LL);
+	cout << isOK(haul.shortestPath("A", "C", path), int64_t(6000000000LL))
+		<< "int64_t weights" << endl;
+
+	BasicGraph<float, uint32_t> latency;
+	latency.add("A", "B", 0.5f);
+	latency.add("B", "C", 0.25f);
+	cout << isOK(latency.bidirectionalShortestPath("A", "C", path), 0.75f)
+		<< "float weights" << endl;
+
+	// int costs stop at INT_MAX instead of wrapping around
+	Graph g;
+	g.add("A", "B", INT_MAX - 1);
+	g.add("B", "C", 5);
+	cout << isOK(g.shortestPath("A", "C", path), INT_MAX)
+		<< "no overflow" << endl;
+
+	// a snapshot only opens with the types it was saved with
+	road.saveBinary("graph_road.bin");
+	BasicCsrGraph<uint16_t, uint16_t> roadCsr;
+	CsrGraph csr;
+	cout << isOK(roadCsr.openBinary("graph_road.bin"), true)
+		<< "open uint16_t snapshot" << endl;
+	cout << isOK(roadCsr.getEdgeWeight("A", "B"), uint16_t(60000))
+		<< "A->B weight" << endl;
+	cout << isOK(roadCsr.getMaxWeight(), road.getWeightProfile().getMaxWeight())
+		<< "profile from header" << endl;
+	cout << isOK(roadCsr.getWeightProfile().getNumEdges(),
+		road.getWeightProfile().getNumEdges()) << "profiled edges" << endl;
+	cout << isOK(csr.openBinary("graph_road.bin"), false)
+		<< "wrong types" << endl;
+
+	writeFile("graph_float.txt", "2\nA B 0.5\nB C +1.25\n");
+	BasicGraph<float, uint32_t> fromFile;
+	cout << isOK(fromFile.readFile("graph_float.txt"), true)
+		<< "read float weights" << endl;
+	cout << isOK(fromFile.getEdgeWeight("B", "C"), 1.25f) << "B->C" << endl;
+	writeFile("graph_nan.txt", "1\nA B nan\n");
+	cout << isOK(fromFile.readFile("graph_nan.txt"), false)
+		<< "NaN weight" << endl;
+	writeFile("graph_inf.txt", "1\nA B inf\n");
+	cout << isOK(fromFile.readFile("graph_inf.txt"), false)
+		<< "infinite weight" << endl;
+	cout << isOK(fromFile.add("A", "D", numeric_limits<float>::infinity()),
+		false) << "add infinite weight" << endl;
+	cout << isOK(fromFile.getNumVertices(), 3) << "no vertex added" << endl;
+	writeFile("graph_wide.txt", "1\nA B 70000\n");
+	cout << isOK(road.readFile("graph_wide.txt"), false)
+		<< "weight out of range" << endl;
+
+	// the largest uint16_t id marks a missing vertex
+	BasicGraph<uint16_t, uint16_t> full;
+	for (int i = 0; i < UINT16_MAX - 1; ++i) {
+		full.add("v", "v" + to_string(i), 1);
+	}
+	cout << isOK(full.getNumVertices(), UINT16_MAX) << "full" << endl;
+	cout << isOK(full.add("v", "one more", 1), false) << "no more ids" << endl;
+	cout << isOK(full.add("one more", "v0", 1), false)
+		<< "new start vertex" << endl;
+	cout << isOK(full.getNumVertices(), UINT16_MAX)
+		<< "start vertex not added" << endl;
+}
+
+void testVisitor() {
+	cout << "testVisitor" << endl;
+	Graph g;
+	g.add("A", "B");
+	g.add("A", "C");
+	g.add("B", "D");
+	g.add("C", "D");
+	g.add("D", "E");
+
+	// the visitor keeps its own state, no global needed
+	ostringstream out;
+	auto record = [&out](string_view label, uint32_t depth) {
+		out << label << depth << " ";
+	};
+	cout << isOK(g.breadthFirstTraversal("A", record), true)
+		<< "BFS runs to the end" << endl;
+	cout << isOK(out.str(), "A0 B1 C1 D2 E3 "s) << "BFS depths" << endl;
+
+	out.str("");
+	g.depthFirstTraversal("A", record);
+	cout << isOK(out.str(), "A0 B1 D2 E3 C1 "s) << "DFS depths" << endl;
+
+	// bounded search, nothing beyond depth 1 is reached
+	out.str("");
+	g.breadthFirstTraversal("A", [&](string_view label, uint32_t depth) {
+		record(label, depth);
+		return depth == 1 ? Visit::SKIP : Visit::CONTINUE;
+	});
+	cout << isOK(out.str(), "A0 B1 C1 "s) << "BFS skip" << endl;
+
+	out.str("");
+	g.depthFirstTraversal("A", [&](string_view label, uint32_t depth) {
+		record(label, depth);
+		return label == "B" ? Visit::SKIP : Visit::CONTINUE;
+	});
+	cout << isOK(out.str(), "A0 B1 C1 D2 E3 "s) << "DFS skip B" << endl;
+
+	out.str("");
+	bool finished = g.breadthFirstTraversal("A",
+		[&](string_view label, uint32_t depth) {
+			record(label, depth);
+			return label == "D" ? Visit::STOP : Visit::CONTINUE;
+		});
+	cout << isOK(finished, false) << "stopped" << endl;
+	cout << isOK(out.str(), "A0 B1 C1 D2 "s) << "stop at D" << endl;
+
+	// the snapshot passes vertex ids
+	CsrGraph csr = g.freeze();
+	uint32_t deepest = 0;
+	csr.breadthFirstTraversal(csr.findVertex("B"),
+		[&](uint32_t id, uint32_t depth) {
+			deepest = depth;
+			return csr.getLabel(id) == "E" ? Visit::STOP : Visit::CONTINUE;
+		});
+	cout << isOK(deepest, 2u) << "B to E in 2" << endl;
+}
+
+void testGenerators() {
+	cout << "testGenerators" << endl;
+	GeneratedGraph rmat = generateRmat(8, 4);
+	cout << isOK(rmat.numVertices, 256u) << "R-MAT vertices" << endl;
+	cout << isOK(rmat.edges.size() <= 1024u, true) << "R-MAT edges" << endl;
+	cout << isOK(generateRmat(8, 4).edges[7].to, rmat.edges[7].to)
+		<< "same seed, same graph" << endl;
+
+	// 3 x 4 grid has 3 * 3 + 2 * 4 neighbors, each joined both ways
+	GeneratedGraph grid = generateGrid(3, 4);
+	cout << isOK(grid.edges.size(), size_t(34)) << "grid edges" << endl;
+
+	GeneratedGraph geometric = generateGeometric(2000, 8);
+	size_t perVertex = geometric.edges.size() / 2000;
+	cout << isOK(perVertex >= 5 && perVertex <= 9, true)
+		<< "geometric degree" << endl;
+
+	GeneratedGraph powerLaw = generatePowerLaw(1000, 3);
+	cout << isOK(powerLaw.edges.size(), size_t(2 * (3 + 3 * 997)))
+		<< "power-law edges" << endl;
+
+	// written edges read back as the same graph
+	cout << isOK(writeEdgeFile(grid, "graph_grid.txt"), true)
+		<< "write grid" << endl;
+	Graph g;
+	cout << isOK(g.readFile("graph_grid.txt"), true) << "read grid" << endl;
+	cout << isOK(g.getNumVertices(), 12) << "grid vertices" << endl;
+	cout << isOK(g.getNumEdges(), 34) << "grid edges read" << endl;
+	// v2 - v3 is the first edge after the 2 pairs out of v0 and v1
+	cout << isOK(g.getEdgeWeight(vertexLabel(2), vertexLabel(3)),
+		grid.edges[8].weight) << "grid weight" << endl;
+}
+
+void testSearchStats() {
+	cout << "testSearchStats" << endl;
+	Graph g;
+	g.add("A", "B", 1);
+	g.add("A", "C", 4);
+	g.add("B", "C", 1);
+	g.add("C", "D", 1);
+
+	// counts are only kept when built with GRAPH_STATS
+	auto expect = [](uint64_t count) {
+		return SearchStats::ENABLED ? count : 0;
+	};
+	SearchWorkspace workspace;
+	const SearchStats& stats = workspace.stats;
+
+	g.breadthFirstTraversal("A", [](string_view, uint32_t) {}, workspace);
+	cout << isOK(stats.getSettled(), expect(4)) << "BFS settled" << endl;
+	cout << isOK(stats.getScanned(), expect(4)) << "BFS scanned" << endl;
+	cout << isOK(stats.getMaxFrontier(), expect(2)) << "BFS widest level"
+		<< endl;
+
+	// A B C D on the stack at once
+	g.depthFirstTraversal("A", [](string_view, uint32_t) {}, workspace);
+	cout << isOK(stats.getScanned(), expect(4)) << "DFS scanned" << endl;
+	cout << isOK(stats.getMaxFrontier(), expect(4)) << "DFS deepest"
+		<< endl;
+
+	// C is pushed at 4, then again at 2 through B, the first entry
+	// is stale when it is popped
+	map<string, int> weight;
+	map<string, string> previous;
+	g.djikstraCostToAllVertices("A", weight, previous, workspace);
+	cout << isOK(weight["D"], 3) << "A to D" << endl;
+	cout << isOK(stats.getPushes(), expect(5)) << "pushes" << endl;
+	cout << isOK(stats.getPops(), expect(5)) << "pops" << endl;
+	cout << isOK(stats.getStale(), expect(1)) << "stale" << endl;
+	cout << isOK(stats.getSettled(), expect(4)) << "settled" << endl;
+	cout << isOK(stats.getSeconds(SearchPhase::OUTPUT) >= 0, true)
+		<< "output timed" << endl;
+}
+
+void testBreadthFirstTree() {
+	cout << "testBreadthFirstTree" << endl;
+	Graph graph;
+	graph.readFile("graph2.txt");
+	CsrGraph small = graph.freeze();
+	vector<uint32_t> hops;
+	vector<uint32_t> parent;
+	small.breadthFirstTree(small.findVertex("D"), hops, parent);
+	cout << isOK(hops[small.findVertex("N")], 2u) << "D to N" << endl;
+	cout << isOK(small.getLabel(parent[small.findVertex("N")]), "I"sv)
+		<< "N after I" << endl;
+	cout << isOK(hops[small.findVertex("A")], CsrGraph::NO_HOPS)
+		<< "A not reached" << endl;
+
+	// large enough for the middle levels to go bottom-up, the hops
+	// must match the plain traversal and each parent be one hop closer
+	Graph g;
+	for (const EdgeFile::Record& edge : generateRmat(11, 16).edges) {
+		g.add(vertexLabel(edge.from), vertexLabel(edge.to), edge.weight);
+	}
+	CsrGraph csr = g.freeze();
+	CsrGraph::Workspace workspace;
+	bool same = true;
+	for (uint32_t source = 0; source < 40; ++source) {
+		vector<uint32_t> depthOf(csr.getNumVertices(), CsrGraph::NO_HOPS);
+		csr.breadthFirstTraversal(source, [&](uint32_t id, uint32_t depth) {
+			depthOf[id] = depth;
+		});
+		csr.breadthFirstTree(source, hops, parent, workspace);
+		same = same && hops == depthOf;
+		for (uint32_t v = 0; v < hops.size(); ++v) {
+			if (parent[v] != CsrGraph::NO_VERTEX) {
+				same = same && hops[parent[v]] + 1 == hops[v] &&
+					csr.getEdgeWeight(csr.getLabel(parent[v]),
+						csr.getLabel(v)) != CsrGraph::NO_EDGE;
+			}
+		}
+	}
+	cout << isOK(same, true) << "same hops as BFS" << endl;
+	cout << isOK(!SearchStats::ENABLED ||
+		workspace.stats.getScanned() < uint64_t(csr.getNumEdges()), true)
+		<< "bottom-up scans fewer edges" << endl;
+}
+
+void testParallelBreadthFirstTree() {
+	cout << "testParallelBreadthFirstTree" << endl;
+	Graph g;
+	for (const EdgeFile::Record& edge : generateRmat(11, 16).edges) {
+		g.add(vertexLabel(edge.from), vertexLabel(edge.to), edge.weight);
+	}
+	CsrGraph csr = g.freeze();
+	uint32_t source = csr.findVertex(vertexLabel(5));
+
+	// the order of the plain traversal, each vertex's parent is the
+	// first vertex in that order with an edge to it
+	vector<uint32_t> expectedOrder;
+	csr.breadthFirstTraversal(source, [&](uint32_t id, uint32_t) {
+		expectedOrder.push_back(id);
+	});
+	vector<uint32_t> expectedParent(csr.getNumVertices(),
+		CsrGraph::NO_VERTEX);
+	for (uint32_t vertex : expectedOrder) {
+		for (uint32_t e = csr.edgesBegin(vertex); e < csr.edgesEnd(vertex);
+			++e) {
+			uint32_t neighbor = csr.getTarget(e);
+			if (neighbor != source &&
+				expectedParent[neighbor] == CsrGraph::NO_VERTEX) {
+				expectedParent[neighbor] = vertex;
+			}
+		}
+	}
+	vector<uint32_t> expectedHops;
+	vector<uint32_t> ignored;
+	csr.breadthFirstTree(source, expectedHops, ignored);
+
+	vector<uint32_t> hops;
+	vector<uint32_t> parent;
+	vector<uint32_t> order;
+	csr.parallelBreadthFirstTree(source, hops, parent, order, 4, true);
+	cout << isOK(order == expectedOrder, true) << "deterministic order"
+		<< endl;
+	cout << isOK(parent == expectedParent, true) << "deterministic parents"
+		<< endl;
+	cout << isOK(hops == expectedHops, true) << "deterministic hops" << endl;
+
+	csr.parallelBreadthFirstTree(source, hops, parent, order, 4);
+	bool valid = order.size() == expectedOrder.size();
+	for (uint32_t v = 0; v < hops.size(); ++v) {
+		if (parent[v] != CsrGraph::NO_VERTEX) {
+			valid = valid && hops[parent[v]] + 1 == hops[v];
+		}
+	}
+	cout << isOK(hops == expectedHops, true) << "any order hops" << endl;
+	cout << isOK(valid, true) << "any order parents" << endl;
+}
+
+void testDeltaStepping() {
+	cout << "testDeltaStepping" << endl;
+	Graph graph;
+	graph.readFile("graph2.txt");
+	map<string, int> weight;
+	map<string, string> previous;
+	map<string, int> deltaWeight;
+	map<string, string> deltaPrevious;
+	graph.djikstraCostToAllVertices("A", weight, previous);
+	graph.deltaSteppingCostToAllVertices("A", deltaWeight, deltaPrevious,
+		0, 3);
+	cout << isOK(deltaWeight == weight, true) << "graph2 weight" << endl;
+	cout << isOK(deltaPrevious == previous, true) << "graph2 previous"
+		<< endl;
+
+	// several bucket widths and thread counts, ties broken the same way
+	Graph g;
+	for (const EdgeFile::Record& edge : generateRmat(10, 8).edges) {
+		g.add(vertexLabel(edge.from), vertexLabel(edge.to),
+			edge.weight % 4 + 1);
+	}
+	CsrGraph csr = g.freeze();
+	vector<int> cost;
+	vector<uint32_t> parent;
+	vector<int> deltaCost;
+	vector<uint32_t> deltaParent;
+	bool same = true;
+	for (uint32_t source = 0; source < 10; ++source) {
+		csr.shortestPathTree(source, cost, parent);
+		for (int delta : { 1, 3, 50 }) {
+			for (unsigned threads : { 1u, 4u }) {
+				csr.deltaSteppingTree(source, deltaCost, deltaParent, delta,
+					threads);
+				same = same && deltaCost == cost && deltaParent == parent;
+			}
+		}
+	}
+	cout << isOK(same, true) << "same tree as Dijkstra" << endl;
+
+	// zero-weight cycle, any parent on a cheapest path will do but
+	// the parents must lead back to the source
+	Graph zero;
+	zero.add("S", "C", 5);
+	zero.add("C", "B", 0);
+	zero.add("B", "A", 0);
+	zero.add("A", "B", 0);
+	CsrGraph zeroCsr = zero.freeze();
+	zeroCsr.deltaSteppingTree(zeroCsr.findVertex("S"), deltaCost,
+		deltaParent, 2, 2);
+	cout << isOK(deltaCost[zeroCsr.findVertex("A")], 5) << "S to A" << endl;
+	cout << isOK(zeroCsr.getLabel(deltaParent[zeroCsr.findVertex("B")]),
+		"C"sv) << "B after C" << endl;
+}
+
+void testBucketQueue() {
+	cout << "testBucketQueue" << endl;
+	// weights 0 to 7 take the bucket queue, float weights always use
+	// the binary heap, both must settle vertices in the same order
+	Graph g;
+	BasicGraph<float, uint32_t> floats;
+	for (const EdgeFile::Record& edge : generateRmat(10, 8).edges) {
+		g.add(vertexLabel(edge.from), vertexLabel(edge.to),
+			edge.weight % 8);
+		floats.add(vertexLabel(edge.from), vertexLabel(edge.to),
+			static_cast<float>(edge.weight % 8));
+	}
+	CsrGraph csr = g.freeze();
+	BasicCsrGraph<float, uint32_t> floatCsr = floats.freeze();
+	cout << isOK(csr.getMaxWeight(), 7) << "max weight" << endl;
+	cout << isOK(csr.getMinWeight(), 0) << "min weight" << endl;
+
+	vector<int> cost;
+	vector<uint32_t> parent;
+	vector<float> floatCost;
+	vector<uint32_t> floatParent;
+	vector<uint32_t> path;
+	vector<uint32_t> floatPath;
+	bool same = true;
+	for (uint32_t source = 0; source < 20; ++source) {
+		csr.shortestPathTree(source, cost, parent);
+		floatCsr.shortestPathTree(source, floatCost, floatParent);
+		same = same && parent == floatParent;
+		for (uint32_t v = 0; v < cost.size(); ++v) {
+			same = same && (cost[v] == CsrGraph::UNREACHABLE ?
+				floatCost[v] == floatCsr.UNREACHABLE :
+				floatCost[v] == static_cast<float>(cost[v]));
+		}
+		csr.shortestPath(source, 300 + source, path);
+		floatCsr.shortestPath(source, 300 + source, floatPath);
+		same = same && path == floatPath;
+	}
+	cout << isOK(same, true) << "buckets match heap" << endl;
+
+	// too heavy for buckets
+	g.add("v0", "heavy", 100000);
+	CsrGraph heavy = g.freeze();
+	cout << isOK(heavy.getMaxWeight(), 100000) << "heavy max weight"
+		<< endl;
+	cout << isOK(g.getEdgeWeight("v0", "heavy"), 100000) << "heavy edge"
+		<< endl;
+	heavy.shortestPathTree(heavy.findVertex("v0"), cost, parent);
+	cout << isOK(cost[heavy.findVertex("heavy")], 100000) << "heavy path"
+		<< endl;
+}
+
+void testWeightProfile() {
+	cout << "testWeightProfile" << endl;
+	Graph profiled;
+	profiled.add("A", "B");
+	profiled.add("A", "C", 1);
+	profiled.add("A", "B", 1);
+	const WeightProfile<int>& profile = profiled.getWeightProfile();
+	cout << isOK(profile.getNumEdges(), static_cast<uint64_t>(2))
+		<< "edge added twice counted once" << endl;
+	cout << isOK(profile.getNumZero(), static_cast<uint64_t>(1))
+		<< "zero weights" << endl;
+	cout << isOK(profile.isZeroOne(), true) << "0/1 weights" << endl;
+	cout << isOK(profile.isUniform(), false) << "not uniform" << endl;
+
+	// 0/1 weights take 0-1 BFS and weight 5 everywhere takes BFS, the
+	// same graphs with an edge too heavy for buckets take the heap.
+	// zz sorts after every vN, so the ids do not change, and nothing
+	// reaches it
+	bool same = true;
+	for (int uniform = 0; uniform < 2; ++uniform) {
+		Graph g;
+		Graph heaped;
+		for (const EdgeFile::Record& edge : generateRmat(10, 8).edges) {
+			int weight = uniform ? 5 : edge.weight % 2;
+			g.add(vertexLabel(edge.from), vertexLabel(edge.to), weight);
+			heaped.add(vertexLabel(edge.from), vertexLabel(edge.to),
+				weight);
+		}
+		heaped.add("zz", "v0", 100000);
+		cout << isOK(g.getWeightProfile().isUniform(), uniform == 1)
+			<< "uniform profile" << endl;
+		cout << isOK(g.freeze().getWeightProfile().getNumEdges(),
+			static_cast<uint64_t>(g.freeze().getNumEdges()))
+			<< "snapshot profile" << endl;
+
+		map<string, int> weights;
+		map<string, string> previous;
+		map<string, int> heapWeights;
+		map<string, string> heapPrevious;
+		vector<string> path;
+		vector<string> heapPath;
+		for (uint32_t source = 0; source < 20; ++source) {
+			g.djikstraCostToAllVertices(vertexLabel(source), weights,
+				previous);
+			heaped.djikstraCostToAllVertices(vertexLabel(source),
+				heapWeights, heapPrevious);
+			same = same && weights == heapWeights &&
+				previous == heapPrevious;
+			int cost = g.shortestPath(vertexLabel(source),
+				vertexLabel(300 + source), path);
+			int heapCost = heaped.shortestPath(vertexLabel(source),
+				vertexLabel(300 + source), heapPath);
+			same = same && cost == heapCost && path == heapPath;
+		}
+	}
+	cout << isOK(same, true) << "levels match heap" << endl;
+}
+
+void testAStar() {
+	cout << "testAStar" << endl;
+	Graph g;
+	g.add("A", "B", 1);
+	g.add("A", "C", 4);
+	g.add("B", "C", 1);
+	g.add("C", "D", 1);
+	vector<string> path;
+	int cost = g.aStarPath("A", "D", path,
+		[](std::string_view label) { return label == "D" ? 0 : 1; });
+	cout << isOK(cost, 3) << "A* cost" << endl;
+	cout << isOK(path.size(), static_cast<size_t>(4)) << "A* path" << endl;
+	cout << isOK(g.aStarPath("D", "A", path,
+		[](std::string_view) { return 0; }), INT_MAX) << "A* unreachable"
+		<< endl;
+
+	// ALT finds the costs Dijkstra finds, with fewer vertices settled
+	Graph grid;
+	for (const EdgeFile::Record& edge : generateGrid(32, 32).edges) {
+		grid.add(vertexLabel(edge.from), vertexLabel(edge.to), edge.weight);
+	}
+	CsrGraph csr = grid.freeze();
+	Landmarks landmarks;
+	landmarks.build(csr, 4);
+	cout << isOK(landmarks.getNumLandmarks(), 4u) << "landmarks" << endl;
+
+	CsrGraph::Workspace workspace;
+	vector<uint32_t> ids;
+	bool same = true;
+	uint64_t dijkstraSettled = 0;
+	uint64_t altSettled = 0;
+	for (uint32_t i = 0; i < 50; ++i) {
+		uint32_t source = i * 37 % 1024;
+		uint32_t target = i * 101 % 1024;
+		int expected = csr.shortestPath(source, target, ids, workspace);
+		dijkstraSettled += workspace.stats.getSettled();
+		int found = landmarks.shortestPath(csr, source, target, ids,
+			workspace);
+		altSettled += workspace.stats.getSettled();
+		same = same && found == expected && ids.front() == source &&
+			ids.back() == target;
+		same = same && landmarks.lowerBound(source, target) <= expected;
+	}
+	cout << isOK(same, true) << "ALT costs" << endl;
+	cout << isOK(!SearchStats::ENABLED ||
+		altSettled <= dijkstraSettled / 2, true)
+		<< "ALT settles fewer" << endl;
+
+	// the tables only load for the snapshot they were built for
+	cout << isOK(landmarks.save("graph_grid.landmarks"), true)
+		<< "save landmarks" << endl;
+	Landmarks loaded;
+	cout << isOK(loaded.load("graph_grid.landmarks", csr), true)
+		<< "load landmarks" << endl;
+	cout << isOK(loaded.getLandmark(3), landmarks.getLandmark(3))
+		<< "loaded landmark" << endl;
+	cout << isOK(loaded.lowerBound(5, 900), landmarks.lowerBound(5, 900))
+		<< "loaded bound" << endl;
+	grid.add("v0", "v999", 1);
+	cout << isOK(loaded.load("graph_grid.landmarks", grid.freeze()), false)
+		<< "other graph" << endl;
+}
+
+void testContractionHierarchy() {
+	cout << "testContractionHierarchy" << endl;
+	Graph g;
+	g.add("A", "B", 1);
+	g.add("A", "C", 4);
+	g.add("B", "C", 1);
+	g.add("C", "D", 1);
+	ContractionHierarchy small;
+	cout << isOK(small.build(g.freeze()), true) << "CH built" << endl;
+	map<string, string> previous;
+	cout << isOK(small.shortestPath("A", "D", previous), 3) << "CH cost"
+		<< endl;
+	cout << isOK(previous["D"], string("C")) << "D via C" << endl;
+	cout << isOK(previous["C"], string("B")) << "C via B" << endl;
+	cout << isOK(previous.size(), static_cast<size_t>(3)) << "path only"
+		<< endl;
+	cout << isOK(small.shortestPath("D", "A", previous), INT_MAX)
+		<< "CH unreachable" << endl;
+	cout << isOK(small.shortestPath("A", "X", previous), INT_MAX)
+		<< "CH no vertex" << endl;
+
+	// the hierarchy finds the costs Dijkstra finds and unpacks the
+	// shortcuts into edges of the grid, settling far fewer vertices
+	Graph grid;
+	for (const EdgeFile::Record& edge : generateGrid(32, 32).edges) {
+		grid.add(vertexLabel(edge.from), vertexLabel(edge.to), edge.weight);
+	}
+	CsrGraph csr = grid.freeze();
+	ContractionHierarchy ch;
+	ch.build(csr);
+	cout << isOK(ch.getNumVertices(), csr.getNumVertices()) << "CH vertices"
+		<< endl;
+
+	CsrGraph::Workspace workspace;
+	vector<uint32_t> ids;
+	bool same = true;
+	bool edges = true;
+	uint64_t dijkstraSettled = 0;
+	uint64_t chSettled = 0;
+	for (uint32_t i = 0; i < 50; ++i) {
+		uint32_t source = i * 37 % 1024;
+		uint32_t target = i * 101 % 1024;
+		int expected = csr.shortestPath(source, target, ids, workspace);
+		dijkstraSettled += workspace.stats.getSettled();
+		int found = ch.shortestPath(source, target, ids, workspace);
+		chSettled += workspace.stats.getSettled();
+		same = same && found == expected && ids.front() == source &&
+			ids.back() == target;
+		int sum = 0;
+		for (size_t k = 1; k < ids.size(); ++k) {
+			int weight = csr.getEdgeWeight(csr.getLabel(ids[k - 1]),
+				csr.getLabel(ids[k]));
+			edges = edges && weight != CsrGraph::NO_EDGE;
+			sum += weight;
+		}
+		edges = edges && sum == expected;
+		same = same && ch.shortestCost(source, target, workspace) == expected;
+	}
+	cout << isOK(same, true) << "CH costs" << endl;
+	cout << isOK(edges, true) << "CH path edges" << endl;
+	cout << isOK(!SearchStats::ENABLED ||
+		chSettled <= dijkstraSettled / 4, true)
+		<< "CH settles fewer" << endl;
+
+	// the hubs of a power-law graph are left as a core, searched with
+	// the landmarks
+	Graph skewed;
+	for (const EdgeFile::Record& edge : generatePowerLaw(1000, 8).edges) {
+		skewed.add(vertexLabel(edge.from), vertexLabel(edge.to),
+			edge.weight);
+	}
+	CsrGraph hubs = skewed.freeze();
+	ContractionHierarchy core;
+	core.build(hubs);
+	cout << isOK(core.getCoreSize() > 0, true) << "CH core" << endl;
+	same = true;
+	for (uint32_t i = 0; i < 50; ++i) {
+		uint32_t source = i * 37 % 1000;
+		uint32_t target = i * 101 % 1000;
+		int expected = hubs.shortestPath(source, target, ids, workspace);
+		int found = core.shortestPath(source, target, ids, workspace);
+		same = same && found == expected && ids.front() == source &&
+			ids.back() == target;
+	}
+	cout << isOK(same, true) << "CH core costs" << endl;
+
+	Graph negative;
+	negative.add("A", "B", 2);
+	negative.add("B", "C", -1);
+	cout << isOK(core.build(negative.freeze()), false) << "CH negative"
+		<< endl;
+	cout << isOK(core.getNumVertices(), 0) << "CH left empty" << endl;
+}
+
+void testTreeCache() {
+	cout << "testTreeCache" << endl;
+	Graph g;
+	g.readFile("graph2.txt");
+	map<string, int> expectedWeight;
+	map<string, string> expectedPrevious;
+	g.djikstraCostToAllVertices("A", expectedWeight, expectedPrevious);
+	cout << isOK(g.getTreeCache().getMisses(), static_cast<uint64_t>(0))
+		<< "cache off" << endl;
+
+	// room for two trees
+	shared_ptr<const Graph::ShortestPathTree> a = g.shortestPathTree("A");
+	g.setTreeCacheBudget(2 * a->getBytes());
+	map<string, int> weight;
+	map<string, string> previous;
+	g.djikstraCostToAllVertices("A", weight, previous);
+	g.djikstraCostToAllVertices("A", weight, previous);
+	cout << isOK(weight == expectedWeight && previous == expectedPrevious,
+		true) << "cached maps" << endl;
+	const Graph::TreeCache& cache = g.getTreeCache();
+	cout << isOK(cache.getMisses(), static_cast<uint64_t>(1)) << "miss"
+		<< endl;
+	cout << isOK(cache.getHits(), static_cast<uint64_t>(1)) << "hit" << endl;
+	a = g.shortestPathTree("A");
+	cout << isOK(a == g.shortestPathTree("A"), true) << "shared tree"
+		<< endl;
+	cout << isOK(a->getCost("F"), expectedWeight["F"]) << "tree cost"
+		<< endl;
+	cout << isOK(string(a->getPrevious("F")), expectedPrevious["F"])
+		<< "tree previous" << endl;
+	cout << isOK(g.shortestPathTree("nope") == nullptr, true)
+		<< "no tree" << endl;
+
+	// B and then C push out A, the least recently used
+	g.shortestPathTree("B");
+	g.shortestPathTree("C");
+	cout << isOK(cache.getEvictions(), static_cast<uint64_t>(1))
+		<< "eviction" << endl;
+	cout << isOK(cache.getNumTrees(), static_cast<size_t>(2)) << "two trees"
+		<< endl;
+	cout << isOK(cache.getBytes(), 2 * a->getBytes()) << "cache bytes"
+		<< endl;
+	cout << isOK(a != g.shortestPathTree("A"), true) << "A searched again"
+		<< endl;
+
+	// a smaller budget drops trees without counting evictions
+	g.setTreeCacheBudget(a->getBytes());
+	cout << isOK(cache.getNumTrees(), static_cast<size_t>(1)) << "one tree"
+		<< endl;
+	cout << isOK(cache.getEvictions(), static_cast<uint64_t>(2))
+		<< "budget change not an eviction" << endl;
+
+	// a change empties the cache, trees already handed out stay valid
+	g.add("A", "F", 1);
+	cout << isOK(cache.getNumTrees(), static_cast<size_t>(0))
+		<< "cleared by add" << endl;
+	cout << isOK(a->getCost("F"), expectedWeight["F"]) << "old tree" << endl;
+	cout << isOK(g.shortestPathTree("A")->getCost("F"), 1) << "new tree"
+		<< endl;
+	g.setTreeCacheBudget(0);
+	cout << isOK(cache.getNumTrees(), static_cast<size_t>(0)) << "cache off"
+		<< endl;
+}
+
+void testDynamicTree() {
+	cout << "testDynamicTree" << endl;
+	Graph g;
+	g.readFile("graph2.txt");
+	cout << isOK(g.trackSource("nope") == nullptr, true) << "no source"
+		<< endl;
+	const DynamicTree* tree = g.trackSource("A");
+	cout << isOK(tree == g.trackSource("A"), true) << "same tree" << endl;
+	map<string, int> expectedWeight;
+	map<string, string> expectedPrevious;
+	map<string, int> weight;
+	map<string, string> previous;
+	g.djikstraCostToAllVertices("A", expectedWeight, expectedPrevious);
+	tree->toMaps(weight, previous);
+	cout << isOK(weight == expectedWeight, true) << "tracked costs" << endl;
+	cout << isOK(tree->getRepaired(), static_cast<uint64_t>(0))
+		<< "nothing repaired" << endl;
+
+	// a shortcut and new vertices only touch the costs that drop
+	g.add("A", "N", 1);
+	g.add("N", "new", 2);
+	g.add("Q", "A", 1);
+	g.djikstraCostToAllVertices("A", expectedWeight, expectedPrevious);
+	tree->toMaps(weight, previous);
+	cout << isOK(weight == expectedWeight, true) << "repaired costs" << endl;
+	cout << isOK(tree->getCost("new"), 3) << "new vertex" << endl;
+	cout << isOK(string(tree->getPrevious("N")), string("A"))
+		<< "new parent" << endl;
+	cout << isOK(tree->getCost("O"), INT_MAX) << "still unreachable"
+		<< endl;
+
+	// random edges one at a time and a whole file at once
+	Graph grown;
+	grown.add("v0", "v1", 5);
+	tree = grown.trackSource("v0");
+	bool same = true;
+	for (uint32_t i = 0; i < 400; ++i) {
+		grown.add(vertexLabel(i * 7 % 60), vertexLabel(i * 13 % 61),
+			static_cast<int>(i * 31 % 17));
+		if (i % 40 == 0) {
+			grown.djikstraCostToAllVertices("v0", expectedWeight,
+				expectedPrevious);
+			tree->toMaps(weight, previous);
+			same = same && weight == expectedWeight;
+		}
+	}
+	grown.readFile("graph2.txt");
+	grown.add("v0", "A", 1);
+	grown.djikstraCostToAllVertices("v0", expectedWeight, expectedPrevious);
+	tree->toMaps(weight, previous);
+	same = same && weight == expectedWeight;
+	cout << isOK(same, true) << "random edges" << endl;
+	cout << isOK(grown.untrackSource("v0"), true) << "untrack" << endl;
+	cout << isOK(grown.untrackSource("v0"), false) << "untracked" << endl;
+}
+
+void testAddEdges() {
+	cout << "testAddEdges" << endl;
+	Graph g;
+	g.add("A", "B", 1);
+	g.add("A", "B", 9);
+	cout << isOK(g.getNumEdges(), 1) << "repeated add counted once" << endl;
+
+	// "A" twice in the labels, repeated edges keep their first weight
+	vector<string> labels = { "B", "A", "C", "A" };
+	vector<Graph::EdgeRecord> edges = { { 1, 0, 5 }, { 1, 2, 2 },
+		{ 1, 2, 3 }, { 3, 2, 4 }, { 2, 3, 1 }, { 0, 2, 7 } };
+	cout << isOK(g.addEdges(labels, edges), true) << "add batch" << endl;
+	cout << isOK(g.getNumVertices(), 3) << "batch vertices" << endl;
+	cout << isOK(g.getNumEdges(), 4) << "batch edges" << endl;
+	cout << isOK(g.getEdgeWeight("A", "B"), 1) << "existing weight" << endl;
+	cout << isOK(g.getEdgeWeight("A", "C"), 2) << "first weight" << endl;
+	cout << isOK(g.getEdgeWeight("C", "A"), 1) << "C to A" << endl;
+	edges.push_back(Graph::EdgeRecord{ 0, 4, 1 });
+	cout << isOK(g.addEdges(labels, edges), false) << "bad index" << endl;
+	cout << isOK(g.getNumEdges(), 4) << "nothing added" << endl;
+
+	// room for one more vertex, a new label listed twice is one vertex
+	BasicGraph<uint16_t, uint16_t> nearlyFull;
+	for (int i = 0; i < UINT16_MAX - 2; ++i) {
+		nearlyFull.add("v", "v" + to_string(i), 1);
+	}
+	vector<string> lastLabels = { "x", "v", "x" };
+	vector<BasicGraph<uint16_t, uint16_t>::EdgeRecord> lastEdges = {
+		{ 0, 1, 1 }, { 2, 1, 2 } };
+	cout << isOK(nearlyFull.addEdges(lastLabels, lastEdges), true)
+		<< "repeated new label" << endl;
+	cout << isOK(nearlyFull.getNumVertices(), UINT16_MAX) << "last vertex"
+		<< endl;
+	cout << isOK(nearlyFull.getNumEdges(), UINT16_MAX - 1) << "one edge"
+		<< endl;
+
+	// a batch builds the same graph as adding edge by edge
+	GeneratedGraph generated = generateRmat(8, 8);
+	vector<string> rmatLabels;
+	for (uint32_t id = 0; id < generated.numVertices; ++id) {
+		rmatLabels.push_back(vertexLabel(id));
+	}
+	Graph one;
+	for (const EdgeFile::Record& edge : generated.edges) {
+		one.add(rmatLabels[edge.from], rmatLabels[edge.to], edge.weight);
+	}
+	Graph batch;
+	batch.addEdges(rmatLabels, generated.edges);
+	cout << isOK(batch.getNumEdges(), one.getNumEdges()) << "same edges"
+		<< endl;
+	cout << isOK(batch.getNumEdges(), one.freeze().getNumEdges())
+		<< "accurate count" << endl;
+	bool same = true;
+	for (const EdgeFile::Record& edge : generated.edges) {
+		same = same && batch.getEdgeWeight(rmatLabels[edge.from],
+			rmatLabels[edge.to]) == one.getEdgeWeight(rmatLabels[edge.from],
+			rmatLabels[edge.to]);
+	}
+	cout << isOK(same, true) << "same weights" << endl;
+	map<string, int> weight;
+	map<string, string> previous;
+	map<string, int> batchWeight;
+	map<string, string> batchPrevious;
+	one.djikstraCostToAllVertices("v0", weight, previous);
+	batch.djikstraCostToAllVertices("v0", batchWeight, batchPrevious);
+	cout << isOK(batchWeight == weight && batchPrevious == previous, true)
+		<< "same paths" << endl;
+}
+
 int main() {
 	testGraph0();
 	testGraph1();
 	testGraph2();
+	testCsrGraph();
+	testDjikstraAfterAdd();
+	testShortestPath();
+	testReadFileErrors();
+	testParallelReadFile();
+	testBinarySnapshot();
+	testSearchWorkspace();
+	testQueryPool();
+	testVertexNeighbors();
+	testArenaGraph();
+	testLabelPool();
+	testWeightTypes();
+	testVisitor();
+	testGenerators();
+	testSearchStats();
+	testBreadthFirstTree();
+	testParallelBreadthFirstTree();
+	testDeltaStepping();
+	testBucketQueue();
+	testWeightProfile();
+	testAStar();
+	testContractionHierarchy();
+	testTreeCache();
+	testDynamicTree();
+	testAddEdges();
 
 	/*Graph g;
 
@@ -0,0 +1,494 @@
+//_____________________________________________________________________________
+// Benchmark: build and search times on generated or given graphs
+//
+// benchmark [scale]                      every generator at 2^scale vertices
+// benchmark rmat|grid|geometric|powerlaw [scale] [edgeFactor]
+// benchmark file <edgefile>              a graph read from an edge file
+// benchmark threads [edgefile]           query throughput by thread count
+//
+// scale defaults to 16 and edgeFactor to 16. rmat makes edgeFactor edges
+// per vertex, geometric about edgeFactor out of each vertex and powerlaw
+// joins each vertex to edgeFactor / 2 earlier ones both ways. grid is as
+// square as 2^scale allows and ignores edgeFactor.
+//
+// Prints one CSV line per graph and operation:
+// add        Graph::add for every edge, labels made before timing
+// add_edges  Graph::addEdges of all the edges as one batch
+// readFile   Graph::readFile of the same edges written to a temp file
+// freeze     Graph::freeze to a CsrGraph
+// dfs, bfs   CsrGraph traversals from SEARCHES random vertices
+// bfs_tree   CsrGraph::breadthFirstTree, direction-optimizing
+// bfs_parallel  CsrGraph::parallelBreadthFirstTree on every core
+// dijkstra   CsrGraph::shortestPathTree from SEARCHES random vertices
+// delta_stepping  CsrGraph::deltaSteppingTree on every core
+// shortest_path  CsrGraph::shortestPath between QUERIES random pairs
+// landmarks  Landmarks::build with LANDMARKS landmarks
+// alt_path   Landmarks::shortestPath, A* between the same pairs
+// ch_build   ContractionHierarchy::build
+// ch_path    ContractionHierarchy::shortestPath between the same pairs
+// sssp_incremental  Graph::add of the last tenth of the edges in BATCHES
+//            batches with the tree of one source tracked
+// sssp_recompute  the same batches, each followed by shortestPathTree
+//            from scratch
+// edges_per_second counts the edges out of every vertex reached, it is
+// empty for the point-to-point searches which stop early. Percentiles
+// are over the runs, peak_rss_kb is the peak resident size of the
+// process so far.
+//
+// g++ -std=c++17 -O2 -pthread benchmark.cpp contraction.cpp csrgraph.cpp
+//     edgefile.cpp graph.cpp graphgen.cpp labelpool.cpp dynamictree.cpp
+//     landmarks.cpp mappedfile.cpp querypool.cpp searchworkspace.cpp
+//     treecache.cpp vertex.cpp -o benchmark
+//_____________________________________________________________________________
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+#include "contraction.h"
+#include "dynamictree.h"
+#include "graph.h"
+#include "graphgen.h"
+#include "landmarks.h"
+#include "querypool.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// This is 80 characters - Keep all lines under 80 characters                 //
+////////////////////////////////////////////////////////////////////////////////
+
+using namespace std;
+
+// traversals and shortestPathTree calls per graph
+const int SEARCHES = 32;
+
+// shortestPath calls per graph
+const int QUERIES = 256;
+
+// landmarks built for the ALT queries
+const unsigned LANDMARKS = 8;
+
+// batches the last tenth of the edges is added in for the incremental
+// shortest-path rows
+const int BATCHES = 32;
+
+// peak resident set size in kB, 0 where it is not known
+long peakRssKb() {
+#ifndef _WIN32
+	rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) == 0) {
+		return usage.ru_maxrss;
+	}
+#endif
+	return 0;
+}
+
+// timed runs of one operation on one graph
+struct Timing {
+	vector<double> seconds;
+	uint64_t edges{ 0 };
+};
+
+// value at fraction of the sorted runs
+double percentile(const vector<double>& sorted, double fraction) {
+	size_t at = static_cast<size_t>(fraction * (sorted.size() - 1) + 0.5);
+	return sorted[at];
+}
+
+// print one CSV line, edges_per_second is empty if no edges were counted
+void report(const string& name, const CsrGraph& csr, const string& operation,
+	Timing timing) {
+	vector<double>& runs = timing.seconds;
+	sort(runs.begin(), runs.end());
+	double total = 0;
+	for (double seconds : runs) {
+		total += seconds;
+	}
+	cout << name << "," << csr.getNumVertices() << "," << csr.getNumEdges()
+		<< "," << operation << "," << runs.size() << "," << total << ",";
+	if (timing.edges > 0 && total > 0) {
+		cout << static_cast<uint64_t>(timing.edges / total);
+	}
+	cout << "," << percentile(runs, 0.5) * 1000 << ","
+		<< percentile(runs, 0.9) * 1000 << ","
+		<< percentile(runs, 0.99) * 1000 << "," << peakRssKb() << endl;
+}
+
+// seconds since start
+double since(chrono::steady_clock::time_point start) {
+	chrono::duration<double> took = chrono::steady_clock::now() - start;
+	return took.count();
+}
+
+// edges out of id
+uint64_t outDegree(const CsrGraph& csr, uint32_t id) {
+	return csr.edgesEnd(id) - csr.edgesBegin(id);
+}
+
+// time traversals and shortest paths on csr, name is the graph column
+void benchmarkSearches(const string& name, const CsrGraph& csr) {
+	if (csr.getNumVertices() == 0) {
+		return;
+	}
+	mt19937 random(7);
+	uniform_int_distribution<uint32_t> vertex(0,
+		static_cast<uint32_t>(csr.getNumVertices() - 1));
+	vector<uint32_t> sources(SEARCHES);
+	for (uint32_t& source : sources) {
+		source = vertex(random);
+	}
+	CsrGraph::Workspace workspace;
+
+	Timing dfs;
+	Timing bfs;
+	for (uint32_t source : sources) {
+		uint64_t edges = 0;
+		auto countEdges = [&csr, &edges](uint32_t id, uint32_t) {
+			edges += outDegree(csr, id);
+		};
+		auto start = chrono::steady_clock::now();
+		csr.depthFirstTraversal(source, countEdges, workspace);
+		dfs.seconds.push_back(since(start));
+		dfs.edges += edges;
+
+		edges = 0;
+		start = chrono::steady_clock::now();
+		csr.breadthFirstTraversal(source, countEdges, workspace);
+		bfs.seconds.push_back(since(start));
+		bfs.edges += edges;
+	}
+	report(name, csr, "dfs", dfs);
+	report(name, csr, "bfs", bfs);
+
+	// counted as the edges out of every vertex reached, like bfs, so
+	// the two rates compare directly
+	Timing bfsTree;
+	vector<uint32_t> hops;
+	vector<uint32_t> hopParent;
+	for (uint32_t source : sources) {
+		auto start = chrono::steady_clock::now();
+		csr.breadthFirstTree(source, hops, hopParent, workspace);
+		bfsTree.seconds.push_back(since(start));
+		for (uint32_t id = 0; id < hops.size(); ++id) {
+			if (hops[id] != CsrGraph::NO_HOPS) {
+				bfsTree.edges += outDegree(csr, id);
+			}
+		}
+	}
+	report(name, csr, "bfs_tree", bfsTree);
+
+	Timing bfsParallel;
+	vector<uint32_t> order;
+	for (uint32_t source : sources) {
+		auto start = chrono::steady_clock::now();
+		csr.parallelBreadthFirstTree(source, hops, hopParent, order);
+		bfsParallel.seconds.push_back(since(start));
+		for (uint32_t id : order) {
+			bfsParallel.edges += outDegree(csr, id);
+		}
+	}
+	report(name, csr, "bfs_parallel", bfsParallel);
+
+	Timing dijkstra;
+	vector<CsrGraph::Cost> cost;
+	vector<uint32_t> parent;
+	for (uint32_t source : sources) {
+		auto start = chrono::steady_clock::now();
+		csr.shortestPathTree(source, cost, parent);
+		dijkstra.seconds.push_back(since(start));
+		for (uint32_t id = 0; id < cost.size(); ++id) {
+			if (cost[id] != CsrGraph::UNREACHABLE) {
+				dijkstra.edges += outDegree(csr, id);
+			}
+		}
+	}
+	report(name, csr, "dijkstra", dijkstra);
+
+	Timing deltaStepping;
+	for (uint32_t source : sources) {
+		auto start = chrono::steady_clock::now();
+		csr.deltaSteppingTree(source, cost, parent);
+		deltaStepping.seconds.push_back(since(start));
+		for (uint32_t id = 0; id < cost.size(); ++id) {
+			if (cost[id] != CsrGraph::UNREACHABLE) {
+				deltaStepping.edges += outDegree(csr, id);
+			}
+		}
+	}
+	report(name, csr, "delta_stepping", deltaStepping);
+
+	Timing queries;
+	vector<uint32_t> path;
+	vector<pair<uint32_t, uint32_t>> pairs(QUERIES);
+	for (pair<uint32_t, uint32_t>& ends : pairs) {
+		ends.first = vertex(random);
+		ends.second = vertex(random);
+		auto start = chrono::steady_clock::now();
+		csr.shortestPath(ends.first, ends.second, path, workspace);
+		queries.seconds.push_back(since(start));
+	}
+	report(name, csr, "shortest_path", queries);
+
+	Timing build;
+	Landmarks landmarks;
+	auto start = chrono::steady_clock::now();
+	landmarks.build(csr, LANDMARKS);
+	build.seconds.push_back(since(start));
+	report(name, csr, "landmarks", build);
+
+	Timing alt;
+	for (const pair<uint32_t, uint32_t>& ends : pairs) {
+		start = chrono::steady_clock::now();
+		landmarks.shortestPath(csr, ends.first, ends.second, path,
+			workspace);
+		alt.seconds.push_back(since(start));
+	}
+	report(name, csr, "alt_path", alt);
+
+	Timing contraction;
+	ContractionHierarchy hierarchy;
+	start = chrono::steady_clock::now();
+	hierarchy.build(csr);
+	contraction.seconds.push_back(since(start));
+	report(name, csr, "ch_build", contraction);
+
+	Timing ch;
+	for (const pair<uint32_t, uint32_t>& ends : pairs) {
+		start = chrono::steady_clock::now();
+		hierarchy.shortestPath(ends.first, ends.second, path, workspace);
+		ch.seconds.push_back(since(start));
+	}
+	report(name, csr, "ch_path", ch);
+}
+
+// time keeping the tree of one source up to date while the last edges
+// of generated are added, against searching again after each batch
+void benchmarkIncremental(const string& name, const GeneratedGraph& generated,
+	const vector<string>& labels, const CsrGraph& csr) {
+	const vector<EdgeFile::Record>& edges = generated.edges;
+	size_t first = edges.size() - edges.size() / 10;
+	if (generated.numVertices == 0 || first == edges.size()) {
+		return;
+	}
+	Graph tracked;
+	Graph plain;
+	for (size_t e = 0; e < first; ++e) {
+		tracked.add(labels[edges[e].from], labels[edges[e].to],
+			edges[e].weight);
+		plain.add(labels[edges[e].from], labels[edges[e].to],
+			edges[e].weight);
+	}
+	const string& source = labels[edges.front().from];
+	tracked.trackSource(source);
+	plain.shortestPathTree(source);
+
+	Timing incremental;
+	Timing recompute;
+	size_t batch = (edges.size() - first + BATCHES - 1) / BATCHES;
+	for (size_t begin = first; begin < edges.size(); begin += batch) {
+		size_t end = min(edges.size(), begin + batch);
+		auto start = chrono::steady_clock::now();
+		for (size_t e = begin; e < end; ++e) {
+			tracked.add(labels[edges[e].from], labels[edges[e].to],
+				edges[e].weight);
+		}
+		incremental.seconds.push_back(since(start));
+
+		start = chrono::steady_clock::now();
+		for (size_t e = begin; e < end; ++e) {
+			plain.add(labels[edges[e].from], labels[edges[e].to],
+				edges[e].weight);
+		}
+		plain.shortestPathTree(source);
+		recompute.seconds.push_back(since(start));
+	}
+	report(name, csr, "sssp_incremental", incremental);
+	report(name, csr, "sssp_recompute", recompute);
+}
+
+// time building generated, then searching it
+void benchmarkGraph(const string& name, const GeneratedGraph& generated) {
+	vector<string> labels(generated.numVertices);
+	for (uint32_t id = 0; id < generated.numVertices; ++id) {
+		labels[id] = vertexLabel(id);
+	}
+
+	Timing add;
+	Graph g;
+	auto start = chrono::steady_clock::now();
+	for (const EdgeFile::Record& edge : generated.edges) {
+		g.add(labels[edge.from], labels[edge.to], edge.weight);
+	}
+	add.seconds.push_back(since(start));
+	add.edges = g.getNumEdges();
+
+	Timing addEdges;
+	Graph batch;
+	start = chrono::steady_clock::now();
+	batch.addEdges(labels, generated.edges);
+	addEdges.seconds.push_back(since(start));
+	addEdges.edges = batch.getNumEdges();
+
+	Timing freeze;
+	start = chrono::steady_clock::now();
+	CsrGraph csr = g.freeze();
+	freeze.seconds.push_back(since(start));
+	freeze.edges = csr.getNumEdges();
+	report(name, csr, "add", add);
+	report(name, csr, "add_edges", addEdges);
+
+	string filename = (filesystem::temp_directory_path() /
+		("benchmark-" + name + ".txt")).string();
+	if (writeEdgeFile(generated, filename)) {
+		Timing read;
+		Graph fromFile;
+		start = chrono::steady_clock::now();
+		fromFile.readFile(filename, 0);
+		read.seconds.push_back(since(start));
+		read.edges = fromFile.getNumEdges();
+		report(name, csr, "readFile", read);
+	}
+	remove(filename.c_str());
+
+	report(name, csr, "freeze", freeze);
+	benchmarkSearches(name, csr);
+	benchmarkIncremental(name, generated, labels, csr);
+}
+
+// generate the graph called name with 2^scale vertices
+bool generate(const string& name, unsigned scale, unsigned edgeFactor,
+	GeneratedGraph& generated) {
+	uint32_t numVertices = static_cast<uint32_t>(1) << scale;
+	if (name == "rmat") {
+		generated = generateRmat(scale, edgeFactor);
+	}
+	else if (name == "grid") {
+		generated = generateGrid(1u << scale / 2, 1u << (scale + 1) / 2);
+	}
+	else if (name == "geometric") {
+		generated = generateGeometric(numVertices, edgeFactor);
+	}
+	else if (name == "powerlaw") {
+		generated = generatePowerLaw(numVertices, max(1u, edgeFactor / 2));
+	}
+	else {
+		return false;
+	}
+	return true;
+}
+
+// seconds taken to answer queries with a pool of threads threads
+double timeBatch(const CsrGraph& csr, vector<Query>& queries,
+	unsigned threads) {
+	QueryPool pool(threads);
+	auto start = chrono::steady_clock::now();
+	pool.run(csr, queries);
+	return since(start);
+}
+
+// query throughput of one graph shared by 1, 2, 4 ... every core
+int benchmarkThreads(int argc, char* argv[]) {
+	Graph g;
+	if (argc > 2) {
+		if (!g.readFile(argv[2], 0)) {
+			return 1;
+		}
+	}
+	else {
+		GeneratedGraph generated = generateRmat(17, 4, 42);
+		for (const EdgeFile::Record& edge : generated.edges) {
+			g.add(vertexLabel(edge.from), vertexLabel(edge.to),
+				edge.weight);
+		}
+	}
+	CsrGraph csr = g.freeze();
+
+	// half shortest-path, half reachability, random endpoints
+	mt19937 random(7);
+	uniform_int_distribution<uint32_t> vertex(0,
+		static_cast<uint32_t>(csr.getNumVertices() - 1));
+	vector<Query> queries(2000);
+	for (size_t i = 0; i < queries.size(); ++i) {
+		queries[i].kind = i % 2 == 0 ? Query::SHORTEST_PATH
+			: Query::REACHABLE;
+		queries[i].source = vertex(random);
+		queries[i].target = vertex(random);
+	}
+
+	unsigned cores = max(1u, thread::hardware_concurrency());
+	cout << "vertices,edges,threads,queries,seconds,queries_per_second"
+		<< endl;
+	for (unsigned threads = 1; ; threads = min(threads * 2, cores)) {
+		double seconds = timeBatch(csr, queries, threads);
+		cout << csr.getNumVertices() << "," << csr.getNumEdges() << ","
+			<< threads << "," << queries.size() << "," << seconds << ","
+			<< queries.size() / seconds << endl;
+		if (threads == cores) {
+			break;
+		}
+	}
+	return 0;
+}
+
+int main(int argc, char* argv[]) {
+	string mode = argc > 1 ? argv[1] : "";
+	if (mode == "threads") {
+		return benchmarkThreads(argc, argv);
+	}
+
+	cout << "graph,vertices,edges,operation,runs,seconds,edges_per_second,"
+		"p50_ms,p90_ms,p99_ms,peak_rss_kb" << endl;
+	if (mode == "file") {
+		if (argc < 3) {
+			cerr << "usage: benchmark file <edgefile>" << endl;
+			return 1;
+		}
+		Timing read;
+		Graph g;
+		auto start = chrono::steady_clock::now();
+		if (!g.readFile(argv[2], 0)) {
+			return 1;
+		}
+		read.seconds.push_back(since(start));
+		read.edges = g.getNumEdges();
+		CsrGraph csr = g.freeze();
+		report(argv[2], csr, "readFile", read);
+		benchmarkSearches(argv[2], csr);
+		return 0;
+	}
+
+	// benchmark [scale] runs every generator
+	bool all = mode.empty() || isdigit(static_cast<unsigned char>(mode[0]));
+	int scaleArg = all ? 1 : 2;
+	unsigned scale = argc > scaleArg ? stoul(argv[scaleArg]) : 16;
+	unsigned edgeFactor = argc > scaleArg + 1 ? stoul(argv[scaleArg + 1])
+		: 16;
+	if (scale < 1 || scale > 30) {
+		cerr << "scale must be 1 to 30" << endl;
+		return 1;
+	}
+
+	vector<string> names = { "rmat", "grid", "geometric", "powerlaw" };
+	if (!all) {
+		names = { mode };
+	}
+	for (const string& name : names) {
+		GeneratedGraph generated;
+		if (!generate(name, scale, edgeFactor, generated)) {
+			cerr << "unknown graph " << name << endl;
+			return 1;
+		}
+		benchmarkGraph(name, generated);
+	}
+	return 0;
+}
@@ -0,0 +1,855 @@
+/**
+* Contraction Hierarchies for fast point-to-point shortest paths
+* The upward and downward edges are stored like the CSR snapshot,
+* one offset array and one edge array each, indexed by vertex id.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "contraction.h"
+#include "searchworkspace.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// This is 80 characters - Keep all lines under 80 characters                 //
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/** contracts the vertices of a snapshot, the remaining graph is kept
+as one list of outgoing and one of incoming links per vertex, the
+links of a vertex are frozen as its upward and downward edges when
+it is contracted */
+template <typename Weight, typename VertexId>
+class Contractor {
+public:
+	typedef typename WeightTraits<Weight>::Cost Cost;
+	typedef std::pair<Cost, VertexId> HeapEntry;
+
+	/** edge between the vertex whose list holds it and other, middle
+	is the vertex a shortcut skips */
+	struct Link {
+		VertexId other;
+		VertexId middle;
+		Cost cost;
+	};
+
+	/** rank of every vertex, filled by run */
+	std::vector<VertexId> rank;
+
+	/** links to higher and from higher ranked vertices, filled by run */
+	std::vector<std::vector<Link>> up;
+	std::vector<std::vector<Link>> down;
+
+	/** shortcuts added or made cheaper */
+	uint32_t numShortcuts{ 0 };
+
+	/** rank of the first core vertex, the number of vertices if the
+	core is empty, filled by run */
+	VertexId coreRank{ 0 };
+
+	/** copy the edges of graph, self loops are left out */
+	explicit Contractor(const BasicCsrGraph<Weight, VertexId>& graph)
+		: rank(graph.getNumVertices()), up(graph.getNumVertices()),
+		down(graph.getNumVertices()), out(graph.getNumVertices()),
+		in(graph.getNumVertices()), contracted(graph.getNumVertices(), 0),
+		deleted(graph.getNumVertices(), 0),
+		difference(graph.getNumVertices(), 0),
+		hops(graph.getNumVertices(), 0), isTarget(graph.getNumVertices(), 0)
+	{
+		VertexId n = static_cast<VertexId>(graph.getNumVertices());
+		for (VertexId v = 0; v < n; ++v) {
+			for (uint32_t e = graph.edgesBegin(v); e < graph.edgesEnd(v);
+				++e) {
+				if (graph.getTarget(e) != v) {
+					link(v, graph.getTarget(e), graph.getWeight(e), NO_MIDDLE);
+				}
+			}
+		}
+		numShortcuts = 0;
+		for (std::vector<Link>& links : out) {
+			std::sort(links.begin(), links.end(),
+				[](const Link& a, const Link& b) { return a.cost < b.cost; });
+		}
+	}
+
+	/** contract the vertices least important first until the links
+	left average CORE_FACTOR times as many per vertex as the snapshot
+	has, the vertices left are the core and rank above the rest
+	priorities are checked again when a vertex comes off the heap and
+	it goes back if it is no longer the least important. Contracting a
+	vertex only adds its neighbors' contracted neighbor term at once,
+	their shortcuts are counted again when they come off the heap. */
+	void run()
+	{
+		VertexId n = static_cast<VertexId>(rank.size());
+		uint64_t coreLinks = std::max<uint64_t>(numLinks, n) *
+			BasicContractionHierarchy<Weight, VertexId>::CORE_FACTOR;
+		std::vector<int64_t> priority(n);
+		std::vector<std::pair<int64_t, VertexId>> queue;
+		std::greater<std::pair<int64_t, VertexId>> after;
+		for (VertexId v = 0; v < n; ++v) {
+			priority[v] = importance(v, ESTIMATE_LIMIT, false);
+			queue.emplace_back(priority[v], v);
+		}
+		std::make_heap(queue.begin(), queue.end(), after);
+
+		VertexId next = 0;
+		std::vector<VertexId> neighbors;
+		while (!queue.empty()) {
+			std::pop_heap(queue.begin(), queue.end(), after);
+			std::pair<int64_t, VertexId> top = queue.back();
+			queue.pop_back();
+			VertexId v = top.second;
+			if (contracted[v] || top.first != priority[v]) {
+				continue;
+			}
+
+			if (numLinks * n > coreLinks * (n - next)) {
+				break;
+			}
+			priority[v] = importance(v, ESTIMATE_LIMIT, false);
+			if (!queue.empty() && priority[v] > queue.front().first) {
+				queue.emplace_back(priority[v], v);
+				std::push_heap(queue.begin(), queue.end(), after);
+				continue;
+			}
+
+			// the shortcuts of v, found with the full witness searches
+			rank[v] = next++;
+			importance(v, BasicContractionHierarchy<Weight,
+				VertexId>::WITNESS_LIMIT, true);
+			contract(v, neighbors);
+			for (VertexId neighbor : neighbors) {
+				priority[neighbor] = difference[neighbor] + deleted[neighbor];
+				queue.emplace_back(priority[neighbor], neighbor);
+				std::push_heap(queue.begin(), queue.end(), after);
+			}
+		}
+
+		coreRank = next;
+		for (VertexId v = 0; v < n; ++v) {
+			if (!contracted[v]) {
+				rank[v] = next++;
+				up[v] = out[v];
+				down[v] = in[v];
+			}
+		}
+	}
+
+private:
+	static constexpr VertexId NO_MIDDLE =
+		BasicCsrGraph<Weight, VertexId>::NO_VERTEX;
+	static constexpr Cost UNREACHABLE = WeightTraits<Weight>::UNREACHABLE;
+
+	/** vertices the witness searches settle when they only estimate
+	how many shortcuts a vertex needs */
+	static constexpr unsigned ESTIMATE_LIMIT = 20;
+
+	/** links a witness path may have */
+	static constexpr unsigned WITNESS_HOPS = 5;
+
+	/** links a witness search relaxes at most, a hub settled early
+	would otherwise have all its links relaxed every time one of its
+	neighbors is contracted */
+	static constexpr unsigned WITNESS_EDGES = 500;
+
+	/** shortcut from - to of cost through the vertex being contracted */
+	struct Shortcut {
+		VertexId from;
+		VertexId to;
+		Cost cost;
+	};
+
+	/** links among the vertices not contracted yet */
+	std::vector<std::vector<Link>> out;
+	std::vector<std::vector<Link>> in;
+
+	/** links in out, each is also in in */
+	uint64_t numLinks{ 0 };
+
+	std::vector<char> contracted;
+
+	/** neighbors of every vertex contracted so far */
+	std::vector<uint32_t> deleted;
+	std::vector<int64_t> difference;
+
+	/** state of the witness searches, isTarget marks the vertices
+	out of the vertex being contracted, targets counts those not
+	settled yet */
+	BasicVertexMarks<Cost, VertexId> witness;
+	std::vector<uint8_t> hops;
+	std::vector<HeapEntry> heap;
+	std::vector<char> isTarget;
+	size_t targets{ 0 };
+
+	/** shortcuts the last call to importance found */
+	std::vector<Shortcut> found;
+
+	/** add the link from - to, or lower its cost if it is cheaper
+	@return  True if the link is new or cheaper. */
+	bool link(VertexId from, VertexId to, Cost cost, VertexId middle)
+	{
+		std::vector<Link>& links = out[from];
+		size_t at = links.size();
+		for (size_t i = 0; i < links.size(); ++i) {
+			if (links[i].other == to) {
+				if (!(cost < links[i].cost)) {
+					return false;
+				}
+				at = i;
+				break;
+			}
+		}
+		if (at == links.size()) {
+			links.push_back(Link{ to, middle, cost });
+			++numLinks;
+			in[to].push_back(Link{ from, middle, cost });
+		}
+		else {
+			links[at].cost = cost;
+			links[at].middle = middle;
+			for (Link& backward : in[to]) {
+				if (backward.other == from) {
+					backward.cost = cost;
+					backward.middle = middle;
+				}
+			}
+		}
+		// keep the links sorted by cost
+		for (; at > 0 && links[at].cost < links[at - 1].cost; --at) {
+			std::swap(links[at], links[at - 1]);
+		}
+		return true;
+	}
+
+	/** remove the link to v from links
+	@return  Number of links removed. */
+	static size_t unlink(std::vector<Link>& links, VertexId v)
+	{
+		size_t size = links.size();
+		links.erase(std::remove_if(links.begin(), links.end(),
+			[v](const Link& l) { return l.other == v; }), links.end());
+		return size - links.size();
+	}
+
+	/** count the shortcuts contracting v needs, keeping them in found
+	only if keep is set, and return its edge difference, shortcuts minus
+	links removed, plus its neighbors contracted already */
+	int64_t importance(VertexId v, unsigned settleLimit, bool keep)
+	{
+		found.clear();
+		int64_t shortcuts = 0;
+		for (const Link& into : in[v]) {
+			Cost limit = 0;
+			for (const Link& from : out[v]) {
+				if (from.other != into.other) {
+					limit = std::max(limit, WeightTraits<Weight>::add(
+						into.cost, from.cost));
+				}
+			}
+			targets = 0;
+			for (const Link& from : out[v]) {
+				targets += from.other != into.other;
+			}
+			witnessSearch(into.other, v, limit, settleLimit);
+			for (const Link& from : out[v]) {
+				Cost through = WeightTraits<Weight>::add(into.cost, from.cost);
+				if (from.other != into.other &&
+					witness.getCost(from.other) > through) {
+					++shortcuts;
+					if (keep) {
+						found.push_back(Shortcut{ into.other, from.other,
+							through });
+					}
+				}
+			}
+		}
+		difference[v] = shortcuts -
+			static_cast<int64_t>(in[v].size() + out[v].size());
+		return difference[v] + deleted[v];
+	}
+
+	/** Dijkstra from source around skip, up to cost limit, until the
+	targets out of skip are settled, settleLimit vertices are settled or
+	WITNESS_EDGES links are relaxed, over paths of at most WITNESS_HOPS
+	links, costs are left in witness. The links are sorted by cost, so
+	the relaxing stops at the first one over limit. */
+	void witnessSearch(VertexId source, VertexId skip, Cost limit,
+		unsigned settleLimit)
+	{
+		for (const Link& target : out[skip]) {
+			isTarget[target.other] = 1;
+		}
+		witness.reset(static_cast<uint32_t>(rank.size()));
+		heap.clear();
+		witness.setCost(source, 0, NO_MIDDLE);
+		hops[source] = 0;
+		heap.emplace_back(0, source);
+		unsigned settled = 0;
+		unsigned relaxed = 0;
+		while (!heap.empty()) {
+			std::pop_heap(heap.begin(), heap.end(),
+				std::greater<HeapEntry>());
+			HeapEntry smallest = heap.back();
+			heap.pop_back();
+			VertexId vertex = smallest.second;
+			if (smallest.first > witness.getCost(vertex)) {
+				continue;
+			}
+			if (smallest.first > limit || settled > settleLimit ||
+				relaxed >= WITNESS_EDGES ||
+				(isTarget[vertex] && vertex != source && --targets == 0)) {
+				break;
+			}
+			++settled;
+			if (hops[vertex] == WITNESS_HOPS) {
+				continue;
+			}
+			for (const Link& next : out[vertex]) {
+				if (next.other == skip) {
+					continue;
+				}
+				Cost challenger = WeightTraits<Weight>::add(smallest.first,
+					next.cost);
+				if (challenger > limit || ++relaxed > WITNESS_EDGES) {
+					break;
+				}
+				if (challenger < witness.getCost(next.other)) {
+					witness.setCost(next.other, challenger, vertex);
+					hops[next.other] = hops[vertex] + 1;
+					heap.emplace_back(challenger, next.other);
+					std::push_heap(heap.begin(), heap.end(),
+						std::greater<HeapEntry>());
+				}
+			}
+		}
+		for (const Link& target : out[skip]) {
+			isTarget[target.other] = 0;
+		}
+	}
+
+	/** freeze the links of v as its upward and downward edges, take v
+	out of the graph and add the shortcuts in found
+	neighbors is filled with the vertices whose links changed */
+	void contract(VertexId v, std::vector<VertexId>& neighbors)
+	{
+		contracted[v] = 1;
+		neighbors.clear();
+		for (const Link& into : in[v]) {
+			numLinks -= unlink(out[into.other], v);
+			neighbors.push_back(into.other);
+		}
+		numLinks -= out[v].size();
+		for (const Link& from : out[v]) {
+			unlink(in[from.other], v);
+			neighbors.push_back(from.other);
+		}
+		std::sort(neighbors.begin(), neighbors.end());
+		neighbors.erase(std::unique(neighbors.begin(), neighbors.end()),
+			neighbors.end());
+		for (VertexId neighbor : neighbors) {
+			deleted[neighbor]++;
+		}
+
+		for (const Shortcut& shortcut : found) {
+			numShortcuts += link(shortcut.from, shortcut.to, shortcut.cost,
+				v);
+		}
+		up[v].swap(out[v]);
+		down[v].swap(in[v]);
+		std::vector<Link>().swap(out[v]);
+		std::vector<Link>().swap(in[v]);
+	}
+};
+
+}  // namespace
+
+/** constructor, empty hierarchy */
+template <typename Weight, typename VertexId>
+BasicContractionHierarchy<Weight, VertexId>::BasicContractionHierarchy()
+	: upOffsets(1, 0), downOffsets(1, 0)
+{
+}
+
+/** contract the vertices of graph */
+template <typename Weight, typename VertexId>
+bool BasicContractionHierarchy<Weight, VertexId>::build(
+	const Snapshot& graph)
+{
+	if (graph.getMinWeight() < 0) {
+		*this = BasicContractionHierarchy();
+		return false;
+	}
+	this->graph = graph;
+	Contractor<Weight, VertexId> contractor(graph);
+	contractor.run();
+
+	// lay the lists out one after the other like the snapshot does
+	typedef typename Contractor<Weight, VertexId>::Link Link;
+	uint32_t n = static_cast<uint32_t>(graph.getNumVertices());
+	rank.swap(contractor.rank);
+	numShortcuts = contractor.numShortcuts;
+	coreRank = contractor.coreRank;
+	landmarks = BasicLandmarks<Weight, VertexId>();
+	if (coreRank < n) {
+		landmarks.build(graph, CORE_LANDMARKS);
+	}
+	upOffsets.assign(1, 0);
+	downOffsets.assign(1, 0);
+	upward.clear();
+	downward.clear();
+	for (uint32_t v = 0; v < n; ++v) {
+		for (const Link& link : contractor.up[v]) {
+			upward.push_back(Arc{ link.other, link.middle, link.cost });
+		}
+		for (const Link& link : contractor.down[v]) {
+			downward.push_back(Arc{ link.other, link.middle, link.cost });
+		}
+		upOffsets.push_back(static_cast<uint32_t>(upward.size()));
+		downOffsets.push_back(static_cast<uint32_t>(downward.size()));
+	}
+	return true;
+}
+
+/** return number of vertices */
+template <typename Weight, typename VertexId>
+int BasicContractionHierarchy<Weight, VertexId>::getNumVertices() const
+{
+	return static_cast<int>(rank.size());
+}
+
+/** return number of upward edges, original edges and shortcuts */
+template <typename Weight, typename VertexId>
+int BasicContractionHierarchy<Weight, VertexId>::getNumEdges() const
+{
+	return static_cast<int>(upward.size() + downward.size());
+}
+
+/** return number of shortcuts added by build */
+template <typename Weight, typename VertexId>
+int BasicContractionHierarchy<Weight, VertexId>::getNumShortcuts() const
+{
+	return static_cast<int>(numShortcuts);
+}
+
+/** return number of vertices left uncontracted in the core */
+template <typename Weight, typename VertexId>
+int BasicContractionHierarchy<Weight, VertexId>::getCoreSize() const
+{
+	return static_cast<int>(rank.size() - coreRank);
+}
+
+/** return the rank of vertex v */
+template <typename Weight, typename VertexId>
+VertexId BasicContractionHierarchy<Weight, VertexId>::getRank(
+	VertexId v) const
+{
+	return rank[v];
+}
+
+/** return the id of the vertex with the given label */
+template <typename Weight, typename VertexId>
+VertexId BasicContractionHierarchy<Weight, VertexId>::findVertex(
+	std::string_view vertexLabel) const
+{
+	return graph.findVertex(vertexLabel);
+}
+
+/** lowest cost from source to target, path is filled with the
+vertices from source to target */
+template <typename Weight, typename VertexId>
+typename BasicContractionHierarchy<Weight, VertexId>::Cost
+BasicContractionHierarchy<Weight, VertexId>::shortestPath(VertexId source,
+	VertexId target, std::vector<VertexId>& path) const
+{
+	Workspace workspace;
+	return shortestPath(source, target, path, workspace);
+}
+
+/** shortestPath keeping its state in workspace
+the forward parents lead from the meeting vertex back to source and
+the backward parents on to target, each step may be a shortcut */
+template <typename Weight, typename VertexId>
+typename BasicContractionHierarchy<Weight, VertexId>::Cost
+BasicContractionHierarchy<Weight, VertexId>::shortestPath(VertexId source,
+	VertexId target, std::vector<VertexId>& path,
+	Workspace& workspace) const
+{
+	path.clear();
+	VertexId meet = NO_VERTEX;
+	Cost cost = search(source, target, workspace, meet);
+	if (meet == NO_VERTEX) {
+		workspace.stats.stop();
+		return UNREACHABLE;
+	}
+
+	workspace.stats.phase(SearchPhase::OUTPUT);
+	std::vector<VertexId> up;
+	for (VertexId v = meet; v != NO_VERTEX;
+		v = workspace.forward.getParent(v)) {
+		up.push_back(v);
+	}
+	path.push_back(source);
+	bool unpacked = true;
+	for (size_t i = up.size() - 1; i > 0 && unpacked; --i) {
+		unpacked = unpack(up[i], up[i - 1], path);
+	}
+	for (VertexId v = meet; v != target && unpacked;) {
+		VertexId next = workspace.backward.getParent(v);
+		unpacked = unpack(v, next, path);
+		v = next;
+	}
+	workspace.stats.stop();
+	if (!unpacked) {
+		path.clear();
+		return UNREACHABLE;
+	}
+	return cost;
+}
+
+/** lowest cost from source to target without unpacking the path */
+template <typename Weight, typename VertexId>
+typename BasicContractionHierarchy<Weight, VertexId>::Cost
+BasicContractionHierarchy<Weight, VertexId>::shortestCost(VertexId source,
+	VertexId target, Workspace& workspace) const
+{
+	VertexId meet = NO_VERTEX;
+	Cost cost = search(source, target, workspace, meet);
+	workspace.stats.stop();
+	return cost;
+}
+
+/** lowest cost from start to target by label, previous is filled for
+the vertices on the path */
+template <typename Weight, typename VertexId>
+typename BasicContractionHierarchy<Weight, VertexId>::Cost
+BasicContractionHierarchy<Weight, VertexId>::shortestPath(
+	std::string_view start, std::string_view target,
+	std::map<std::string, std::string>& previous) const
+{
+	previous.clear();
+	VertexId from = findVertex(start);
+	VertexId to = findVertex(target);
+	if (from == NO_VERTEX || to == NO_VERTEX) {
+		return UNREACHABLE;
+	}
+
+	std::vector<VertexId> path;
+	Cost cost = shortestPath(from, to, path);
+	for (size_t i = 1; i < path.size(); ++i) {
+		previous.emplace(graph.getLabel(path[i]),
+			graph.getLabel(path[i - 1]));
+	}
+	return cost;
+}
+
+/** upward searches from source and target
+the direction with the cheaper next vertex goes first, each stops
+once its next vertex costs no less than the best path found. A vertex
+that a higher ranked vertex reaches more cheaply is stalled, its edges
+cannot be on a cheapest path. */
+template <typename Weight, typename VertexId>
+typename BasicContractionHierarchy<Weight, VertexId>::Cost
+BasicContractionHierarchy<Weight, VertexId>::search(VertexId source,
+	VertexId target, Workspace& workspace, VertexId& meet) const
+{
+	if (coreRank < rank.size()) {
+		return coreSearch(source, target, workspace, meet);
+	}
+
+	typedef typename Workspace::HeapEntry HeapEntry;
+	SearchStats& stats = workspace.stats;
+	stats.clear();
+
+	// index 0 is the forward search over upward edges, index 1 the
+	// backward search over downward edges
+	BasicVertexMarks<Cost, VertexId>* marks[2] = { &workspace.forward,
+		&workspace.backward };
+	std::vector<HeapEntry>* pq[2] = { &workspace.heap[0],
+		&workspace.heap[1] };
+	const std::vector<uint32_t>* offsets[2] = { &upOffsets, &downOffsets };
+	const std::vector<Arc>* arcs[2] = { &upward, &downward };
+	uint32_t n = static_cast<uint32_t>(rank.size());
+	for (int side = 0; side < 2; ++side) {
+		marks[side]->reset(n);
+		pq[side]->clear();
+	}
+	stats.phase(SearchPhase::SEARCH);
+
+	marks[0]->setCost(source, 0, NO_VERTEX);
+	pq[0]->emplace_back(0, source);
+	marks[1]->setCost(target, 0, NO_VERTEX);
+	pq[1]->emplace_back(0, target);
+	stats.push(1);
+
+	Cost best = UNREACHABLE;
+	meet = NO_VERTEX;
+	while (true) {
+		bool open[2];
+		for (int side = 0; side < 2; ++side) {
+			open[side] = !pq[side]->empty() &&
+				pq[side]->front().first < best;
+		}
+		if (!open[0] && !open[1]) {
+			break;
+		}
+		int side = open[0] && (!open[1] ||
+			pq[0]->front().first <= pq[1]->front().first) ? 0 : 1;
+		std::vector<HeapEntry>& heap = *pq[side];
+		BasicVertexMarks<Cost, VertexId>& mine = *marks[side];
+		BasicVertexMarks<Cost, VertexId>& other = *marks[1 - side];
+
+		std::pop_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+		HeapEntry smallest = heap.back();
+		heap.pop_back();
+		stats.pop();
+		VertexId vertex = smallest.second;
+		if (smallest.first > mine.getCost(vertex)) {
+			stats.stale();
+			continue;
+		}
+		stats.settle();
+
+		if (other.isReached(vertex)) {
+			Cost total = WeightTraits<Weight>::add(smallest.first,
+				other.getCost(vertex));
+			if (total < best) {
+				best = total;
+				meet = vertex;
+			}
+		}
+
+		// the edges of the other direction lead down to vertex, from
+		// a vertex this search may have reached more cheaply
+		const std::vector<uint32_t>& stallOffsets = *offsets[1 - side];
+		const std::vector<Arc>& stallArcs = *arcs[1 - side];
+		bool stalled = false;
+		for (uint32_t e = stallOffsets[vertex];
+			e < stallOffsets[vertex + 1] && !stalled; ++e) {
+			stalled = WeightTraits<Weight>::add(
+				mine.getCost(stallArcs[e].other), stallArcs[e].cost) <
+				smallest.first;
+		}
+		if (stalled) {
+			continue;
+		}
+
+		const std::vector<uint32_t>& edgeOffsets = *offsets[side];
+		const std::vector<Arc>& edgeArcs = *arcs[side];
+		stats.scan(edgeOffsets[vertex + 1] - edgeOffsets[vertex]);
+		for (uint32_t e = edgeOffsets[vertex]; e < edgeOffsets[vertex + 1];
+			++e) {
+			VertexId neighbor = edgeArcs[e].other;
+			Cost challenger = WeightTraits<Weight>::add(smallest.first,
+				edgeArcs[e].cost);
+			if (challenger < mine.getCost(neighbor)) {
+				mine.setCost(neighbor, challenger, vertex);
+				heap.emplace_back(challenger, neighbor);
+				std::push_heap(heap.begin(), heap.end(),
+					std::greater<HeapEntry>());
+				stats.push(heap.size());
+			}
+		}
+	}
+	return best;
+}
+
+/** upward search from target and A* from source
+the backward search runs to the end but stops at core vertices, it is
+the upward search space of target below the core. The forward search
+goes up from source and on through the core, keyed by cost plus the
+landmark lower bound to target, and stops once no key is below the
+best path through a vertex the backward search reached. Shortcuts are
+real paths, so the bound is never above the cost left. */
+template <typename Weight, typename VertexId>
+typename BasicContractionHierarchy<Weight, VertexId>::Cost
+BasicContractionHierarchy<Weight, VertexId>::coreSearch(VertexId source,
+	VertexId target, Workspace& workspace, VertexId& meet) const
+{
+	typedef typename Workspace::HeapEntry HeapEntry;
+	SearchStats& stats = workspace.stats;
+	stats.clear();
+	BasicVertexMarks<Cost, VertexId>& forward = workspace.forward;
+	BasicVertexMarks<Cost, VertexId>& backward = workspace.backward;
+	uint32_t n = static_cast<uint32_t>(rank.size());
+	forward.reset(n);
+	backward.reset(n);
+	std::vector<HeapEntry>& up = workspace.heap[0];
+	std::vector<HeapEntry>& down = workspace.heap[1];
+	up.clear();
+	down.clear();
+	stats.phase(SearchPhase::SEARCH);
+	meet = NO_VERTEX;
+
+	backward.setCost(target, 0, NO_VERTEX);
+	down.emplace_back(0, target);
+	stats.push(1);
+	while (!down.empty()) {
+		std::pop_heap(down.begin(), down.end(), std::greater<HeapEntry>());
+		HeapEntry smallest = down.back();
+		down.pop_back();
+		stats.pop();
+		VertexId vertex = smallest.second;
+		if (smallest.first > backward.getCost(vertex)) {
+			stats.stale();
+			continue;
+		}
+		stats.settle();
+		if (rank[vertex] >= coreRank) {
+			continue;
+		}
+
+		bool stalled = false;
+		for (uint32_t e = upOffsets[vertex]; e < upOffsets[vertex + 1] &&
+			!stalled; ++e) {
+			stalled = WeightTraits<Weight>::add(
+				backward.getCost(upward[e].other), upward[e].cost) <
+				smallest.first;
+		}
+		if (stalled) {
+			continue;
+		}
+
+		stats.scan(downOffsets[vertex + 1] - downOffsets[vertex]);
+		for (uint32_t e = downOffsets[vertex]; e < downOffsets[vertex + 1];
+			++e) {
+			VertexId neighbor = downward[e].other;
+			Cost challenger = WeightTraits<Weight>::add(smallest.first,
+				downward[e].cost);
+			if (challenger < backward.getCost(neighbor)) {
+				backward.setCost(neighbor, challenger, vertex);
+				down.emplace_back(challenger, neighbor);
+				std::push_heap(down.begin(), down.end(),
+					std::greater<HeapEntry>());
+				stats.push(down.size());
+			}
+		}
+	}
+
+	Cost best = UNREACHABLE;
+	Cost estimate = landmarks.lowerBound(source, target);
+	if (estimate != UNREACHABLE) {
+		forward.setCost(source, 0, NO_VERTEX);
+		up.emplace_back(estimate, source);
+		stats.push(1);
+	}
+	while (!up.empty() && up.front().first < best) {
+		std::pop_heap(up.begin(), up.end(), std::greater<HeapEntry>());
+		HeapEntry smallest = up.back();
+		up.pop_back();
+		stats.pop();
+		VertexId vertex = smallest.second;
+		Cost reached = forward.getCost(vertex);
+		if (smallest.first > WeightTraits<Weight>::add(reached,
+			landmarks.lowerBound(vertex, target))) {
+			stats.stale();
+			continue;
+		}
+		stats.settle();
+
+		if (backward.isReached(vertex)) {
+			Cost total = WeightTraits<Weight>::add(reached,
+				backward.getCost(vertex));
+			if (total < best) {
+				best = total;
+				meet = vertex;
+			}
+		}
+
+		bool stalled = false;
+		for (uint32_t e = downOffsets[vertex];
+			e < downOffsets[vertex + 1] && !stalled; ++e) {
+			stalled = WeightTraits<Weight>::add(
+				forward.getCost(downward[e].other), downward[e].cost) <
+				reached;
+		}
+		if (stalled) {
+			continue;
+		}
+
+		stats.scan(upOffsets[vertex + 1] - upOffsets[vertex]);
+		for (uint32_t e = upOffsets[vertex]; e < upOffsets[vertex + 1];
+			++e) {
+			VertexId neighbor = upward[e].other;
+			Cost challenger = WeightTraits<Weight>::add(reached,
+				upward[e].cost);
+			if (challenger < forward.getCost(neighbor)) {
+				estimate = landmarks.lowerBound(neighbor, target);
+				if (estimate == UNREACHABLE) {
+					continue;
+				}
+				forward.setCost(neighbor, challenger, vertex);
+				up.emplace_back(WeightTraits<Weight>::add(challenger,
+					estimate), neighbor);
+				std::push_heap(up.begin(), up.end(),
+					std::greater<HeapEntry>());
+				stats.push(up.size());
+			}
+		}
+	}
+	return best;
+}
+
+/** append the original edges of arc from - to to path
+a shortcut through m is the arc from - m followed by m - to, both
+stored with m since m was contracted before from and to */
+template <typename Weight, typename VertexId>
+bool BasicContractionHierarchy<Weight, VertexId>::unpack(VertexId from,
+	VertexId to, std::vector<VertexId>& path) const
+{
+	std::vector<std::pair<VertexId, VertexId>> pending;
+	pending.emplace_back(from, to);
+	while (!pending.empty()) {
+		std::pair<VertexId, VertexId> arc = pending.back();
+		pending.pop_back();
+		const Arc* found = findArc(arc.first, arc.second);
+		if (!found) {
+			return false;
+		}
+		VertexId middle = found->middle;
+		if (middle == NO_VERTEX) {
+			path.push_back(arc.second);
+			continue;
+		}
+		pending.emplace_back(middle, arc.second);
+		pending.emplace_back(arc.first, middle);
+	}
+	return true;
+}
+
+/** the arc from - to, kept with whichever end was contracted first
+build keeps at most one arc per pair, the cheapest */
+template <typename Weight, typename VertexId>
+const typename BasicContractionHierarchy<Weight, VertexId>::Arc*
+BasicContractionHierarchy<Weight, VertexId>::findArc(VertexId from,
+	VertexId to) const
+{
+	if (rank[from] < rank[to]) {
+		for (uint32_t e = upOffsets[from]; e < upOffsets[from + 1]; ++e) {
+			if (upward[e].other == to) {
+				return &upward[e];
+			}
+		}
+	}
+	else {
+		for (uint32_t e = downOffsets[to]; e < downOffsets[to + 1]; ++e) {
+			if (downward[e].other == from) {
+				return &downward[e];
+			}
+		}
+	}
+	return nullptr;
+}
+
+// the weight and id types listed in graph.cpp
+template class BasicContractionHierarchy<int, uint32_t>;
+template class BasicContractionHierarchy<uint16_t, uint16_t>;
+template class BasicContractionHierarchy<uint32_t, uint32_t>;
+template class BasicContractionHierarchy<int64_t, uint32_t>;
+template class BasicContractionHierarchy<float, uint32_t>;
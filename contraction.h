@@ -0,0 +1,196 @@
+/**
+* Contraction Hierarchies for fast point-to-point shortest paths
+* build contracts the vertices of a snapshot one at a time, least
+* important first, and adds a shortcut u - w through v whenever the
+* only cheapest path from u to w goes through the vertex v being
+* contracted. A vertex is more important the later it is contracted,
+* its rank. Importance is the edge difference, shortcuts added minus
+* edges removed, plus the neighbors already contracted, and is updated
+* lazily. Witness searches, which look for a path around v, stop after
+* a few hops, settled vertices or relaxed edges and then add the
+* shortcut, which is never wrong, only an extra edge.
+* Once the vertices left average twice the edges per vertex of the
+* snapshot, as around the hubs of skewed graphs where every further
+* vertex would take quadratic witness searches, they are kept as an
+* uncontracted core of the highest ranks.
+* Without a core a query searches upward from both ends at once,
+* forward from the source over edges to higher ranked vertices and
+* backward from the target over edges from higher ranked vertices.
+* With one the backward search stops at the core and the forward search
+* runs on through it as A* with landmark lower bounds. Shortcuts
+* remember the vertex they skip, so the path is unpacked into the
+* original edges.
+* Measured with benchmark at 2^16 vertices, median query against
+* CsrGraph::shortestPath and Landmarks::shortestPath:
+*   grid       build 2.5 s, 0.20 ms against 4.8 and 0.50 ms
+*   geometric  build 27 s, 0.34 ms against 11.6 and 1.4 ms
+*   R-MAT      build 19 s, 3.8 ms against 10.6 and 3.4 ms
+*   power-law  build 31 s, 7.1 ms against 14.5 and 6.1 ms
+* The cores of R-MAT and power-law graphs hold about half and three
+* quarters of the vertices, so there the query is ALT with more edges,
+* and Landmarks alone is as fast and builds in well under a second.
+* The hierarchy keeps a copy of the snapshot, which shares its arrays,
+* for the labels and the vertex count. Queries are const and can run
+* at the same time as long as each thread uses its own workspace.
+*/
+
+#ifndef CONTRACTION_H
+#define CONTRACTION_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "csrgraph.h"
+#include "landmarks.h"
+#include "weighttraits.h"
+
+/** Weight and VertexId are those of the snapshot, see csrgraph.h */
+template <typename Weight, typename VertexId>
+class BasicContractionHierarchy {
+public:
+	/** snapshot the hierarchy is built for */
+	typedef BasicCsrGraph<Weight, VertexId> Snapshot;
+
+	/** type path costs are added up in, also the type of shortcut
+	weights */
+	typedef typename WeightTraits<Weight>::Cost Cost;
+
+	/** per-query state, the same as for searches on the snapshot */
+	typedef typename Snapshot::Workspace Workspace;
+
+	/** cost of a vertex that cannot be reached */
+	static constexpr Cost UNREACHABLE = WeightTraits<Weight>::UNREACHABLE;
+
+	/** returned by findVertex if the label does not exist and the
+	middle of an edge that is not a shortcut */
+	static constexpr VertexId NO_VERTEX = Snapshot::NO_VERTEX;
+
+	/** vertices a witness search settles before it gives up and the
+	shortcut is added */
+	static constexpr unsigned WITNESS_LIMIT = 100;
+
+	/** the vertices left become the core once they average this many
+	times the edges per vertex of the snapshot */
+	static constexpr unsigned CORE_FACTOR = 2;
+
+	/** landmarks build picks to search the core */
+	static constexpr unsigned CORE_LANDMARKS = 16;
+
+	/** constructor, empty hierarchy */
+	BasicContractionHierarchy();
+
+	/** contract the vertices of graph, replacing the hierarchy held
+	before
+	@return  False, leaving the hierarchy empty, if graph has a negative
+	weight. */
+	bool build(const Snapshot& graph);
+
+	/** return number of vertices */
+	int getNumVertices() const;
+
+	/** return number of upward edges, original edges and shortcuts */
+	int getNumEdges() const;
+
+	/** return number of shortcuts added by build */
+	int getNumShortcuts() const;
+
+	/** return number of vertices left uncontracted in the core */
+	int getCoreSize() const;
+
+	/** return the rank of vertex v, 0 was contracted first */
+	VertexId getRank(VertexId v) const;
+
+	/** return the id of the vertex with the given label
+	returns NO_VERTEX if the vertex does not exist */
+	VertexId findVertex(std::string_view vertexLabel) const;
+
+	/** lowest cost from source to target, UNREACHABLE if unreachable
+	path is filled with the vertices from source to target. When
+	there are several cheapest paths the one found may differ from
+	CsrGraph::shortestPath. A shortcut that cannot be unpacked, which
+	only a broken hierarchy has, also gives UNREACHABLE and an empty
+	path. */
+	Cost shortestPath(VertexId source, VertexId target,
+		std::vector<VertexId>& path) const;
+
+	/** shortestPath keeping its state in workspace */
+	Cost shortestPath(VertexId source, VertexId target,
+		std::vector<VertexId>& path, Workspace& workspace) const;
+
+	/** lowest cost from source to target without unpacking the path */
+	Cost shortestCost(VertexId source, VertexId target,
+		Workspace& workspace) const;
+
+	/** lowest cost from start to target by label, UNREACHABLE if either
+	does not exist or target cannot be reached
+	previous is filled like Graph::djikstraCostToAllVertices fills it,
+	but only for the vertices on the path:
+	previous["F"] = "C" indicates get to "F" via "C" */
+	Cost shortestPath(std::string_view start, std::string_view target,
+		std::map<std::string, std::string>& previous) const;
+
+private:
+	/** edge of the hierarchy, its other end and, for a shortcut, the
+	vertex it skips */
+	struct Arc {
+		VertexId other;
+		VertexId middle;
+		Cost cost;
+	};
+
+	/** the snapshot the hierarchy was built for */
+	Snapshot graph;
+
+	/** rank of every vertex */
+	std::vector<VertexId> rank;
+
+	/** upward[upOffsets[v] .. upOffsets[v + 1] - 1] are the edges v - w
+	to higher ranked vertices w, or to every core vertex w if v is in
+	the core */
+	std::vector<uint32_t> upOffsets;
+	std::vector<Arc> upward;
+
+	/** downward[downOffsets[v] .. downOffsets[v + 1] - 1] are the edges
+	u - v from higher ranked vertices u, other is u */
+	std::vector<uint32_t> downOffsets;
+	std::vector<Arc> downward;
+
+	/** shortcuts added by build */
+	uint32_t numShortcuts{ 0 };
+
+	/** rank of the first core vertex, the number of vertices if every
+	vertex was contracted */
+	VertexId coreRank{ 0 };
+
+	/** landmarks of the snapshot that guide the search through the
+	core, none if there is no core */
+	BasicLandmarks<Weight, VertexId> landmarks;
+
+	/** search both ways, leave the searches in workspace and return the
+	cost and the vertex where the cheapest path meets */
+	Cost search(VertexId source, VertexId target, Workspace& workspace,
+		VertexId& meet) const;
+
+	/** search when there is a core, upward from target up to the core
+	and then A* from source through the core, same results as search */
+	Cost coreSearch(VertexId source, VertexId target, Workspace& workspace,
+		VertexId& meet) const;
+
+	/** append the original edges of arc from - to to path, which
+	already ends with from
+	@return  False if an arc it needs is missing from the hierarchy. */
+	bool unpack(VertexId from, VertexId to, std::vector<VertexId>& path)
+		const;
+
+	/** the arc from - to, nullptr if there is none, build keeps at
+	most one arc per pair */
+	const Arc* findArc(VertexId from, VertexId to) const;
+};  // end BasicContractionHierarchy
+
+/** hierarchy of the default CsrGraph */
+typedef BasicContractionHierarchy<int, uint32_t> ContractionHierarchy;
+
+#endif  // CONTRACTION_H
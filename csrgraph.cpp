@@ -0,0 +1,1608 @@
+/**
+* Compressed sparse row (CSR) snapshot of a Graph
+* Every vertex is given a dense VertexId. Ids are handed out in label
+* order, so the neighbors of a vertex are stored in the same alphabetical
+* order the Graph uses and the traversals visit vertices in the same order.
+* The arrays live in one block laid out like the binary snapshot file:
+* a Header, then labelOffsets, labelBytes, offsets, targets, weights,
+* reverseOffsets, sources and reverseWeights, each 8-byte aligned.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "csrgraph.h"
+#include "graph.h"
+#include "mappedfile.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// This is 80 characters - Keep all lines under 80 characters                 //
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/** first bytes of every snapshot file */
+const char MAGIC[8] = { 'C', 'S', 'R', 'G', 'R', 'A', 'P', 'H' };
+
+/** bumped whenever the layout below changes */
+const uint32_t VERSION = 3;
+
+/** written in native byte order, tells if a file was written on a
+machine with a different byte order */
+const uint32_t ENDIAN_MARK = 0x01020304;
+
+/** start of a snapshot block, the arrays follow it */
+struct Header {
+	char magic[8];
+	uint32_t version;
+	uint32_t byteOrder;
+	uint32_t weightType;
+	uint32_t idType;
+	uint64_t numVertices;
+	uint64_t numEdges;
+	uint64_t numLabelBytes;
+	uint64_t size;
+
+	/** the WeightProfile of the weights array, so opening a file does
+	not read every weight, minWeight and maxWeight hold the bytes of
+	a Weight */
+	uint64_t numProfiled;
+	uint64_t numZero;
+	uint64_t numOne;
+	unsigned char minWeight[8];
+	unsigned char maxWeight[8];
+};
+
+/** byte position of every array in a snapshot block, each one is
+8-byte aligned so the arrays can be used straight from a mapping */
+struct Layout {
+	size_t labelOffsets;
+	size_t labelBytes;
+	size_t offsets;
+	size_t targets;
+	size_t weights;
+	size_t reverseOffsets;
+	size_t sources;
+	size_t reverseWeights;
+	size_t size;
+};
+
+/** size of T, 0x100 added for floating point and 0x200 for signed
+types, written to the header so a file is only opened with the
+weight and id types it was saved with */
+template <typename T>
+uint32_t typeCode()
+{
+	return static_cast<uint32_t>(sizeof(T)) +
+		(std::is_floating_point<T>::value ? 0x100 : 0) +
+		(std::is_signed<T>::value ? 0x200 : 0);
+}
+
+/** round n up to a multiple of 8 */
+size_t align8(size_t n)
+{
+	return (n + 7) & ~static_cast<size_t>(7);
+}
+
+/** where the arrays go for a graph of the given size */
+template <typename Weight, typename VertexId>
+Layout layoutFor(uint64_t numVertices, uint64_t numEdges,
+	uint64_t numLabelBytes)
+{
+	Layout layout;
+	size_t at = align8(sizeof(Header));
+	layout.labelOffsets = at;
+	at = align8(at + (numVertices + 1) * sizeof(uint64_t));
+	layout.labelBytes = at;
+	at = align8(at + numLabelBytes);
+	layout.offsets = at;
+	at = align8(at + (numVertices + 1) * sizeof(uint32_t));
+	layout.targets = at;
+	at = align8(at + numEdges * sizeof(VertexId));
+	layout.weights = at;
+	at = align8(at + numEdges * sizeof(Weight));
+	layout.reverseOffsets = at;
+	at = align8(at + (numVertices + 1) * sizeof(uint32_t));
+	layout.sources = at;
+	at = align8(at + numEdges * sizeof(VertexId));
+	layout.reverseWeights = at;
+	at = align8(at + numEdges * sizeof(Weight));
+	layout.size = at;
+	return layout;
+}
+
+/** allocate a zeroed, 8-byte aligned snapshot block with its header
+filled in, storage takes ownership of it */
+template <typename Weight, typename VertexId>
+char* allocate(std::shared_ptr<const void>& storage, uint64_t numVertices,
+	uint64_t numEdges, uint64_t numLabelBytes)
+{
+	Layout layout = layoutFor<Weight, VertexId>(numVertices, numEdges,
+		numLabelBytes);
+	auto block = std::make_shared<std::vector<uint64_t>>(layout.size / 8);
+	storage = block;
+
+	char* base = reinterpret_cast<char*>(block->data());
+	Header header = Header();
+	std::copy(MAGIC, MAGIC + sizeof(MAGIC), header.magic);
+	header.version = VERSION;
+	header.byteOrder = ENDIAN_MARK;
+	header.weightType = typeCode<Weight>();
+	header.idType = typeCode<VertexId>();
+	header.numVertices = numVertices;
+	header.numEdges = numEdges;
+	header.numLabelBytes = numLabelBytes;
+	header.size = layout.size;
+	std::memcpy(base, &header, sizeof(header));
+	return base;
+}
+
+/** write profile into the header of the snapshot block at base */
+template <typename Weight>
+void storeProfile(char* base, const WeightProfile<Weight>& profile)
+{
+	static_assert(sizeof(Weight) <= sizeof(Header::minWeight),
+		"weights are stored in 8 bytes");
+	Header header;
+	std::memcpy(&header, base, sizeof(header));
+	header.numProfiled = profile.getNumEdges();
+	header.numZero = profile.getNumZero();
+	header.numOne = profile.getNumOne();
+	Weight minWeight = profile.getMinWeight();
+	Weight maxWeight = profile.getMaxWeight();
+	std::memcpy(header.minWeight, &minWeight, sizeof(Weight));
+	std::memcpy(header.maxWeight, &maxWeight, sizeof(Weight));
+	std::memcpy(base, &header, sizeof(header));
+}
+
+/** the WeightProfile stored in header */
+template <typename Weight>
+WeightProfile<Weight> loadProfile(const Header& header)
+{
+	Weight minWeight;
+	Weight maxWeight;
+	std::memcpy(&minWeight, header.minWeight, sizeof(Weight));
+	std::memcpy(&maxWeight, header.maxWeight, sizeof(Weight));
+	return WeightProfile<Weight>(header.numProfiled, header.numZero,
+		header.numOne, minWeight, maxWeight);
+}
+
+/** True if none of the count values goes down */
+template <typename T>
+bool nonDecreasing(const T* values, uint64_t count)
+{
+	for (uint64_t i = 1; i < count; ++i) {
+		if (values[i] < values[i - 1]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/** True if all count ids are below numVertices */
+template <typename VertexId>
+bool allBelow(const VertexId* ids, uint64_t count, uint64_t numVertices)
+{
+	for (uint64_t i = 0; i < count; ++i) {
+		if (ids[i] >= numVertices) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/** top-down steps turn bottom-up once the edges out of a growing
+frontier are more than 1 / TOP_DOWN_ALPHA of the edges into unreached
+vertices */
+const uint64_t TOP_DOWN_ALPHA = 14;
+
+/** bottom-up steps turn top-down once a shrinking frontier holds fewer
+than 1 / BOTTOM_UP_BETA of the vertices */
+const uint64_t BOTTOM_UP_BETA = 24;
+
+/** threads wait in wait() until all count of them have arrived */
+class Barrier {
+public:
+	explicit Barrier(unsigned count) : count(count) {}
+
+	/** return once every thread has called wait */
+	void wait()
+	{
+		std::unique_lock<std::mutex> guard(lock);
+		uint64_t arrived = generation;
+		if (++waiting == count) {
+			waiting = 0;
+			generation++;
+			everyone.notify_all();
+			return;
+		}
+		everyone.wait(guard, [&] { return generation != arrived; });
+	}
+
+private:
+	std::mutex lock;
+	std::condition_variable everyone;
+	unsigned count;
+	unsigned waiting{ 0 };
+
+	/** bumped each time all threads have arrived */
+	uint64_t generation{ 0 };
+};
+
+/** lower value to candidate if candidate is smaller */
+void atomicMin(std::atomic<uint64_t>& value, uint64_t candidate)
+{
+	uint64_t current = value.load(std::memory_order_relaxed);
+	while (candidate < current &&
+		!value.compare_exchange_weak(current, candidate,
+			std::memory_order_relaxed)) {
+	}
+}
+
+/** add entry to a binary heap with the smallest cost on top */
+template <typename HeapEntry>
+void pushHeap(std::vector<HeapEntry>& heap, const HeapEntry& entry)
+{
+	heap.push_back(entry);
+	std::push_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+}
+
+/** remove and return the entry with the smallest cost */
+template <typename HeapEntry>
+HeapEntry popHeap(std::vector<HeapEntry>& heap)
+{
+	std::pop_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+	HeapEntry smallest = heap.back();
+	heap.pop_back();
+	return smallest;
+}
+
+/** binary heap of (cost, vertex) entries, smallest cost and then
+smallest vertex on top */
+template <typename Cost, typename VertexId>
+class BinaryHeap {
+public:
+	typedef std::pair<Cost, VertexId> Entry;
+
+	/** use heap, emptied first */
+	explicit BinaryHeap(std::vector<Entry>& heap) : heap(heap)
+	{
+		heap.clear();
+	}
+
+	bool empty() const { return heap.empty(); }
+	size_t size() const { return heap.size(); }
+	void push(Cost cost, VertexId v) { pushHeap(heap, Entry(cost, v)); }
+	Entry pop() { return popHeap(heap); }
+
+private:
+	std::vector<Entry>& heap;
+};
+
+/** Dial's bucket queue for integer weights from 0 to maxWeight
+every cost waiting is between the cost last popped and that plus
+maxWeight, so maxWeight + 1 buckets used in a circle hold them all.
+The bucket being emptied is kept as a heap of vertex ids, so entries
+come out in the same order as from BinaryHeap. */
+template <typename Cost, typename VertexId>
+class BucketQueue {
+public:
+	typedef std::pair<Cost, VertexId> Entry;
+
+	/** use buckets, which must be empty */
+	BucketQueue(std::vector<std::vector<VertexId>>& buckets,
+		uint64_t maxWeight) : buckets(buckets)
+	{
+		buckets.resize(maxWeight + 1);
+	}
+
+	/** leave the buckets empty for the next search */
+	~BucketQueue()
+	{
+		for (Cost at = current; waiting > 0; ++at) {
+			waiting -= buckets[at % buckets.size()].size();
+			buckets[at % buckets.size()].clear();
+		}
+	}
+
+	bool empty() const { return waiting == 0; }
+	size_t size() const { return waiting; }
+
+	/** cost is never below the cost last popped */
+	void push(Cost cost, VertexId v)
+	{
+		std::vector<VertexId>& bucket = buckets[cost % buckets.size()];
+		bucket.push_back(v);
+		if (cost == current && heaped) {
+			std::push_heap(bucket.begin(), bucket.end(),
+				std::greater<VertexId>());
+		}
+		++waiting;
+	}
+
+	Entry pop()
+	{
+		while (buckets[current % buckets.size()].empty()) {
+			++current;
+			heaped = false;
+		}
+		std::vector<VertexId>& bucket = buckets[current % buckets.size()];
+		if (!heaped) {
+			std::make_heap(bucket.begin(), bucket.end(),
+				std::greater<VertexId>());
+			heaped = true;
+		}
+		std::pop_heap(bucket.begin(), bucket.end(), std::greater<VertexId>());
+		VertexId v = bucket.back();
+		bucket.pop_back();
+		--waiting;
+		return Entry(current, v);
+	}
+
+private:
+	std::vector<std::vector<VertexId>>& buckets;
+
+	/** cost of the bucket being emptied */
+	Cost current{ 0 };
+
+	/** True once the bucket at current is a heap */
+	bool heaped{ false };
+
+	/** entries in all buckets */
+	size_t waiting{ 0 };
+};
+
+/** queue of 0-1 BFS, also breadth-first search when every weight is
+the same w
+every cost waiting is the cost last popped or that plus one weight,
+so two levels hold them all, like the two ends of the deque of 0-1
+BFS. A level is sorted by vertex id once it is reached and vertices
+pushed at its own cost over zero-weight edges wait in a small heap
+beside it, so entries come out in the same order as from BinaryHeap.
+Costs are never added up here, which also lets float weights use it. */
+template <typename Cost, typename VertexId>
+class LevelQueue {
+public:
+	typedef std::pair<Cost, VertexId> Entry;
+
+	/** use level, nextLevel and sameLevel, emptied first */
+	LevelQueue(std::vector<VertexId>& level,
+		std::vector<VertexId>& nextLevel, std::vector<VertexId>& sameLevel)
+		: level(level), nextLevel(nextLevel), sameLevel(sameLevel)
+	{
+		level.clear();
+		nextLevel.clear();
+		sameLevel.clear();
+	}
+
+	bool empty() const { return size() == 0; }
+
+	size_t size() const
+	{
+		return level.size() + nextLevel.size() + sameLevel.size();
+	}
+
+	/** cost is the cost last popped or one weight more */
+	void push(Cost cost, VertexId v)
+	{
+		if (cost == current) {
+			sameLevel.push_back(v);
+			std::push_heap(sameLevel.begin(), sameLevel.end(),
+				std::greater<VertexId>());
+		}
+		else {
+			nextLevel.push_back(v);
+			nextCost = cost;
+		}
+	}
+
+	Entry pop()
+	{
+		if (level.empty() && sameLevel.empty()) {
+			// highest id first, so the lowest comes off the back
+			level.swap(nextLevel);
+			std::sort(level.begin(), level.end(), std::greater<VertexId>());
+			current = nextCost;
+		}
+		VertexId v;
+		if (!sameLevel.empty() &&
+			(level.empty() || sameLevel.front() < level.back())) {
+			std::pop_heap(sameLevel.begin(), sameLevel.end(),
+				std::greater<VertexId>());
+			v = sameLevel.back();
+			sameLevel.pop_back();
+		}
+		else {
+			v = level.back();
+			level.pop_back();
+		}
+		return Entry(current, v);
+	}
+
+private:
+	std::vector<VertexId>& level;
+	std::vector<VertexId>& nextLevel;
+	std::vector<VertexId>& sameLevel;
+
+	/** cost of the entries in level and sameLevel, and in nextLevel */
+	Cost current{ 0 };
+	Cost nextCost{ 0 };
+};
+
+}  // namespace
+
+/** constructor, empty graph */
+template <typename Weight, typename VertexId>
+BasicCsrGraph<Weight, VertexId>::BasicCsrGraph()
+{
+	attach(allocate<Weight, VertexId>(storage, 0, 0, 0));
+}
+
+/** constructor, copies the vertices and edges of graph */
+template <typename Weight, typename VertexId>
+BasicCsrGraph<Weight, VertexId>::BasicCsrGraph(
+	const BasicGraph<Weight, VertexId>& graph)
+{
+	// the graph numbers its labels in the order they were added,
+	// sorting them gives the ids
+	uint64_t vertexCount = graph.vertices.size();
+	std::vector<LabelPool::Label> byId(vertexCount);
+	for (uint32_t label = 0; label < vertexCount; ++label) {
+		byId[label] = label;
+	}
+	std::sort(byId.begin(), byId.end(),
+		[&graph](LabelPool::Label left, LabelPool::Label right) {
+			return graph.labels.view(left) < graph.labels.view(right);
+		});
+	std::vector<VertexId> idOf(vertexCount);
+	for (uint32_t id = 0; id < vertexCount; ++id) {
+		idOf[byId[id]] = static_cast<VertexId>(id);
+	}
+
+	uint64_t edgeCount = 0;
+	uint64_t labelByteCount = graph.labels.getNumBytes();
+	for (const BasicVertex<Weight>* vertex : graph.vertices) {
+		edgeCount += vertex->neighbors().size();
+	}
+	if (edgeCount > MAX_EDGES) {
+		attach(allocate<Weight, VertexId>(storage, 0, 0, 0));
+		return;
+	}
+
+	char* base = allocate<Weight, VertexId>(storage, vertexCount, edgeCount,
+		labelByteCount);
+	Layout layout = layoutFor<Weight, VertexId>(vertexCount, edgeCount,
+		labelByteCount);
+	uint64_t* labelOffsetsOut =
+		reinterpret_cast<uint64_t*>(base + layout.labelOffsets);
+	char* labelBytesOut = base + layout.labelBytes;
+	uint32_t* offsetsOut = reinterpret_cast<uint32_t*>(base + layout.offsets);
+	VertexId* targetsOut = reinterpret_cast<VertexId*>(base + layout.targets);
+	Weight* weightsOut = reinterpret_cast<Weight*>(base + layout.weights);
+	uint32_t* reverseOffsetsOut =
+		reinterpret_cast<uint32_t*>(base + layout.reverseOffsets);
+	VertexId* sourcesOut = reinterpret_cast<VertexId*>(base + layout.sources);
+	Weight* reverseWeightsOut =
+		reinterpret_cast<Weight*>(base + layout.reverseWeights);
+
+	uint64_t labelAt = 0;
+	for (uint32_t id = 0; id < vertexCount; ++id) {
+		std::string_view label = graph.labels.view(byId[id]);
+		labelOffsetsOut[id] = labelAt;
+		std::memcpy(labelBytesOut + labelAt, label.data(), label.size());
+		labelAt += label.size();
+	}
+	labelOffsetsOut[vertexCount] = labelAt;
+
+	attach(base);
+
+	// neighbors come in label order, so each run of targets is sorted
+	uint32_t e = 0;
+	for (uint32_t id = 0; id < vertexCount; ++id) {
+		offsetsOut[id] = e;
+		for (typename BasicVertex<Weight>::Neighbor neighbor :
+			graph.vertices[byId[id]]->neighbors()) {
+			targetsOut[e] = idOf[neighbor.id];
+			weightsOut[e] = neighbor.weight;
+			e++;
+		}
+	}
+	offsetsOut[vertexCount] = e;
+
+	// count the edges into every vertex, then turn the counts
+	// into offsets
+	for (e = 0; e < edgeCount; ++e) {
+		reverseOffsetsOut[targetsOut[e] + 1]++;
+	}
+	for (uint32_t v = 1; v <= vertexCount; ++v) {
+		reverseOffsetsOut[v] += reverseOffsetsOut[v - 1];
+	}
+
+	// walking the start vertices in id order keeps each run of
+	// sources sorted
+	std::vector<uint32_t> next(reverseOffsetsOut,
+		reverseOffsetsOut + vertexCount);
+	for (uint32_t v = 0; v < vertexCount; ++v) {
+		for (e = offsetsOut[v]; e < offsetsOut[v + 1]; ++e) {
+			uint32_t slot = next[targetsOut[e]]++;
+			sourcesOut[slot] = static_cast<VertexId>(v);
+			reverseWeightsOut[slot] = weightsOut[e];
+		}
+	}
+	weightProfile = graph.weightProfile;
+	storeProfile(base, weightProfile);
+}
+
+/** point the arrays into the snapshot block starting at base */
+template <typename Weight, typename VertexId>
+void BasicCsrGraph<Weight, VertexId>::attach(const char* base)
+{
+	Header header;
+	std::memcpy(&header, base, sizeof(header));
+	Layout layout = layoutFor<Weight, VertexId>(header.numVertices,
+		header.numEdges, header.numLabelBytes);
+
+	block = base;
+	numVertices = static_cast<uint32_t>(header.numVertices);
+	numEdges = static_cast<uint32_t>(header.numEdges);
+	labelOffsets =
+		reinterpret_cast<const uint64_t*>(base + layout.labelOffsets);
+	labelBytes = base + layout.labelBytes;
+	offsets = reinterpret_cast<const uint32_t*>(base + layout.offsets);
+	targets = reinterpret_cast<const VertexId*>(base + layout.targets);
+	weights = reinterpret_cast<const Weight*>(base + layout.weights);
+	reverseOffsets =
+		reinterpret_cast<const uint32_t*>(base + layout.reverseOffsets);
+	sources = reinterpret_cast<const VertexId*>(base + layout.sources);
+	reverseWeights =
+		reinterpret_cast<const Weight*>(base + layout.reverseWeights);
+}
+
+/** True if the weights are all the same or all 0 or 1, none negative */
+template <typename Weight, typename VertexId>
+bool BasicCsrGraph<Weight, VertexId>::useLevels() const
+{
+	return weightProfile.getMinWeight() >= 0 &&
+		(weightProfile.isUniform() || weightProfile.isZeroOne());
+}
+
+/** True if the weights are integers from 0 to MAX_BUCKET_WEIGHT */
+template <typename Weight, typename VertexId>
+bool BasicCsrGraph<Weight, VertexId>::useBuckets() const
+{
+	return std::is_integral<Weight>::value &&
+		weightProfile.getMinWeight() >= 0 &&
+		static_cast<uint64_t>(weightProfile.getMaxWeight()) <=
+		MAX_BUCKET_WEIGHT;
+}
+
+/** write the snapshot to filename in the binary snapshot format
+@return  True if the whole file was written. */
+template <typename Weight, typename VertexId>
+bool BasicCsrGraph<Weight, VertexId>::saveBinary(
+	const std::string& filename) const
+{
+	Header header;
+	std::memcpy(&header, block, sizeof(header));
+
+	std::ofstream fout(filename, std::ios::binary | std::ios::trunc);
+	fout.write(block, static_cast<std::streamsize>(header.size));
+	fout.close();
+	return static_cast<bool>(fout);
+}
+
+/** replace this snapshot with one written by saveBinary, checking
+the offsets and ids if check is set
+@return  False, leaving this snapshot as it was, if the file
+cannot be opened, is not a snapshot of this version with
+these weight and id types or fails the checks. */
+template <typename Weight, typename VertexId>
+bool BasicCsrGraph<Weight, VertexId>::openBinary(const std::string& filename,
+	bool check)
+{
+	auto file = std::make_shared<MappedFile>();
+	if (!file->open(filename, false) || file->size() < sizeof(Header)) {
+		return false;
+	}
+
+	Header header;
+	std::memcpy(&header, file->data(), sizeof(header));
+	if (!std::equal(MAGIC, MAGIC + sizeof(MAGIC), header.magic) ||
+		header.version != VERSION || header.byteOrder != ENDIAN_MARK ||
+		header.weightType != typeCode<Weight>() ||
+		header.idType != typeCode<VertexId>() ||
+		header.numVertices >= NO_VERTEX || header.numEdges > MAX_EDGES) {
+		return false;
+	}
+
+	Layout layout = layoutFor<Weight, VertexId>(header.numVertices,
+		header.numEdges, header.numLabelBytes);
+	if (header.size != layout.size || file->size() != layout.size) {
+		return false;
+	}
+
+	// the last entry of each offset array must close off its array
+	const char* base = file->data();
+	const uint64_t* lastLabel = reinterpret_cast<const uint64_t*>(
+		base + layout.labelOffsets) + header.numVertices;
+	const uint32_t* lastEdge = reinterpret_cast<const uint32_t*>(
+		base + layout.offsets) + header.numVertices;
+	const uint32_t* lastReverse = reinterpret_cast<const uint32_t*>(
+		base + layout.reverseOffsets) + header.numVertices;
+	if (*lastLabel != header.numLabelBytes ||
+		*lastEdge != header.numEdges || *lastReverse != header.numEdges) {
+		return false;
+	}
+
+	// with the runs in order and every id a vertex, no query can read
+	// past an array
+	uint64_t n = header.numVertices + 1;
+	if (check && (!nonDecreasing(lastLabel - header.numVertices, n) ||
+		!nonDecreasing(lastEdge - header.numVertices, n) ||
+		!nonDecreasing(lastReverse - header.numVertices, n) ||
+		!allBelow(reinterpret_cast<const VertexId*>(base + layout.targets),
+			header.numEdges, header.numVertices) ||
+		!allBelow(reinterpret_cast<const VertexId*>(base + layout.sources),
+			header.numEdges, header.numVertices))) {
+		return false;
+	}
+
+	storage = file;
+	attach(base);
+	weightProfile = loadProfile<Weight>(header);
+	return true;
+}
+
+/** return number of vertices */
+template <typename Weight, typename VertexId>
+int BasicCsrGraph<Weight, VertexId>::getNumVertices() const
+{
+	return static_cast<int>(numVertices);
+}
+
+/** return number of edges */
+template <typename Weight, typename VertexId>
+int BasicCsrGraph<Weight, VertexId>::getNumEdges() const
+{
+	return static_cast<int>(numEdges);
+}
+
+/** return the id of the vertex with the given label
+returns NO_VERTEX if the vertex does not exist */
+template <typename Weight, typename VertexId>
+VertexId BasicCsrGraph<Weight, VertexId>::findVertex(
+	std::string_view vertexLabel) const
+{
+	// binary search, labels are sorted by id
+	uint32_t low = 0;
+	uint32_t high = numVertices;
+	while (low < high) {
+		uint32_t middle = low + (high - low) / 2;
+		if (getLabel(middle) < vertexLabel) {
+			low = middle + 1;
+		}
+		else {
+			high = middle;
+		}
+	}
+
+	if (low == numVertices || getLabel(low) != vertexLabel) {
+		return NO_VERTEX;
+	}
+	return static_cast<VertexId>(low);
+}
+
+/** return the label of the vertex with the given id */
+template <typename Weight, typename VertexId>
+std::string_view BasicCsrGraph<Weight, VertexId>::getLabel(VertexId id) const
+{
+	return std::string_view(labelBytes + labelOffsets[id],
+		labelOffsets[id + 1] - labelOffsets[id]);
+}
+
+/** return weight of the edge between start and end
+returns NO_EDGE if not connected or vertices don't exist */
+template <typename Weight, typename VertexId>
+Weight BasicCsrGraph<Weight, VertexId>::getEdgeWeight(std::string_view start,
+	std::string_view end) const
+{
+	VertexId from = findVertex(start);
+	VertexId to = findVertex(end);
+	if (from == NO_VERTEX || to == NO_VERTEX) {
+		return NO_EDGE;
+	}
+
+	// neighbors are sorted by id, so binary search the edge run
+	const VertexId* first = targets + edgesBegin(from);
+	const VertexId* last = targets + edgesEnd(from);
+	const VertexId* it = std::lower_bound(first, last, to);
+	if (it == last || *it != to) {
+		return NO_EDGE;
+	}
+	return weights[it - targets];
+}
+
+/** depth-first traversal starting from startLabel
+call the function visit on each vertex label */
+template <typename Weight, typename VertexId>
+void BasicCsrGraph<Weight, VertexId>::depthFirstTraversal(
+	std::string_view startLabel,
+	void visit(const std::string&)) const
+{
+	Workspace workspace;
+	depthFirstTraversal(startLabel, visit, workspace);
+}
+
+/** depth-first traversal keeping its state in workspace */
+template <typename Weight, typename VertexId>
+void BasicCsrGraph<Weight, VertexId>::depthFirstTraversal(
+	std::string_view startLabel, void visit(const std::string&),
+	Workspace& workspace) const
+{
+	VertexId start = findVertex(startLabel);
+	if (start == NO_VERTEX) {
+		return;
+	}
+
+	depthFirstTraversal(start, [&](VertexId id, uint32_t) {
+		visit(std::string(getLabel(id)));
+	}, workspace);
+}
+
+/** breadth-first traversal starting from startLabel
+call the function visit on each vertex label */
+template <typename Weight, typename VertexId>
+void BasicCsrGraph<Weight, VertexId>::breadthFirstTraversal(
+	std::string_view startLabel,
+	void visit(const std::string&)) const
+{
+	Workspace workspace;
+	breadthFirstTraversal(startLabel, visit, workspace);
+}
+
+/** breadth-first traversal keeping its state in workspace */
+template <typename Weight, typename VertexId>
+void BasicCsrGraph<Weight, VertexId>::breadthFirstTraversal(
+	std::string_view startLabel, void visit(const std::string&),
+	Workspace& workspace) const
+{
+	VertexId start = findVertex(startLabel);
+	if (start == NO_VERTEX) {
+		return;
+	}
+
+	breadthFirstTraversal(start, [&](VertexId id, uint32_t) {
+		visit(std::string(getLabel(id)));
+	}, workspace);
+}
+
+/** level-synchronous breadth-first search from vertex source
+direction-optimizing as described by Beamer, Asanovic and Patterson */
+template <typename Weight, typename VertexId>
+void BasicCsrGraph<Weight, VertexId>::breadthFirstTree(VertexId source,
+	std::vector<uint32_t>& hops, std::vector<VertexId>& parent) const
+{
+	Workspace workspace;
+	breadthFirstTree(source, hops, parent, workspace);
+}
+
+/** breadthFirstTree keeping its frontier in workspace */
+template <typename Weight, typename VertexId>
+void BasicCsrGraph<Weight, VertexId>::breadthFirstTree(VertexId source,
+	std::vector<uint32_t>& hops, std::vector<VertexId>& parent,
+	Workspace& workspace) const
+{
+	SearchStats& stats = workspace.stats;
+	stats.clear();
+	hops.assign(numVertices, NO_HOPS);
+	parent.assign(numVertices, NO_VERTEX);
+	std::vector<VertexId>& frontier = workspace.queue;
+	std::vector<VertexId>& next = workspace.nextQueue;
+	std::vector<uint64_t>& bits = workspace.levelBits;
+	frontier.clear();
+	stats.phase(SearchPhase::SEARCH);
+
+	hops[source] = 0;
+	frontier.push_back(source);
+	stats.settle();
+
+	// edges into vertices not reached yet, what a bottom-up step
+	// would scan at most
+	uint64_t unreachedEdges = numEdges -
+		(reverseEdgesEnd(source) - reverseEdgesBegin(source));
+	bool bottomUp = false;
+	size_t lastSize = 0;
+
+	for (uint32_t depth = 0; !frontier.empty(); ++depth) {
+		stats.frontier(frontier.size());
+		if (bottomUp) {
+			bool shrinking = frontier.size() < lastSize;
+			bottomUp = !shrinking ||
+				frontier.size() * BOTTOM_UP_BETA >= numVertices;
+		}
+		else {
+			uint64_t frontierEdges = 0;
+			for (VertexId vertex : frontier) {
+				frontierEdges += edgesEnd(vertex) - edgesBegin(vertex);
+			}
+			// a shrinking frontier near the end of a long search would
+			// make every level scan all vertices, so it stays top-down
+			bottomUp = frontier.size() > lastSize &&
+				frontierEdges * TOP_DOWN_ALPHA > unreachedEdges;
+		}
+		lastSize = frontier.size();
+		next.clear();
+
+		if (bottomUp) {
+			// every vertex not reached looks for an edge in from the
+			// frontier, it stops at the first one
+			bits.assign((numVertices + 63) / 64, 0);
+			for (VertexId vertex : frontier) {
+				bits[vertex / 64] |= uint64_t(1) << vertex % 64;
+			}
+			for (uint32_t v = 0; v < numVertices; ++v) {
+				if (hops[v] != NO_HOPS) {
+					continue;
+				}
+				for (uint32_t e = reverseEdgesBegin(v);
+					e < reverseEdgesEnd(v); ++e) {
+					VertexId from = sources[e];
+					if (bits[from / 64] >> from % 64 & 1) {
+						stats.scan(e - reverseEdgesBegin(v) + 1);
+						hops[v] = depth + 1;
+						parent[v] = from;
+						next.push_back(static_cast<VertexId>(v));
+						break;
+					}
+				}
+				if (hops[v] == NO_HOPS) {
+					stats.scan(reverseEdgesEnd(v) - reverseEdgesBegin(v));
+				}
+			}
+		}
+		else {
+			for (VertexId vertex : frontier) {
+				stats.scan(edgesEnd(vertex) - edgesBegin(vertex));
+				for (uint32_t e = edgesBegin(vertex); e < edgesEnd(vertex);
+					++e) {
+					VertexId neighbor = targets[e];
+					if (hops[neighbor] == NO_HOPS) {
+						hops[neighbor] = depth + 1;
+						parent[neighbor] = vertex;
+						next.push_back(neighbor);
+					}
+				}
+			}
+		}
+
+		for (VertexId vertex : next) {
+			unreachedEdges -= reverseEdgesEnd(vertex) -
+				reverseEdgesBegin(vertex);
+			stats.settle();
+		}
+		frontier.swap(next);
+	}
+	stats.stop();
+}
+
+/** breadthFirstTree with each level split over threads
+a bitmap of atomic words marks the vertices reached. In deterministic
+mode a first pass has every vertex keep the lowest position in the
+level that has an edge to it, a second pass lets only that position
+take it, so each buffer holds what one thread would have found. */
+template <typename Weight, typename VertexId>
+void BasicCsrGraph<Weight, VertexId>::parallelBreadthFirstTree(
+	VertexId source, std::vector<uint32_t>& hops,
+	std::vector<VertexId>& parent, std::vector<VertexId>& order,
+	unsigned threads, bool deterministic) const
+{
+	if (threads == 0) {
+		threads = std::max(1u, std::thread::hardware_concurrency());
+	}
+	hops.assign(numVertices, NO_HOPS);
+	parent.assign(numVertices, NO_VERTEX);
+	order.resize(numVertices);
+
+	std::vector<std::atomic<uint64_t>> reached((numVertices + 63) / 64);
+	auto isReached = [&reached](VertexId v) {
+		return reached[v / 64].load(std::memory_order_relaxed) >>
+			v % 64 & 1;
+	};
+	// True for the one caller that marks v
+	auto reach = [&reached](VertexId v) {
+		uint64_t bit = uint64_t(1) << v % 64;
+		return !(reached[v / 64].fetch_or(bit, std::memory_order_relaxed) &
+			bit);
+	};
+
+	// depth in the high half, position in the level in the low half,
+	// so claims left from earlier levels never match
+	std::vector<std::atomic<uint64_t>> claims(deterministic ?
+		numVertices : 0);
+	for (std::atomic<uint64_t>& claim : claims) {
+		claim.store(UINT64_MAX, std::memory_order_relaxed);
+	}
+
+	hops[source] = 0;
+	reach(source);
+	order[0] = source;
+	size_t numReached = 1;
+
+	std::vector<std::vector<VertexId>> found(threads);
+	Barrier barrier(threads);
+
+	// every thread works out the same level bounds on its own
+	auto search = [&](unsigned worker) {
+		std::vector<VertexId>& mine = found[worker];
+		size_t levelBegin = 0;
+		size_t levelEnd = 1;
+		for (uint32_t depth = 0; levelBegin < levelEnd; ++depth) {
+			size_t size = levelEnd - levelBegin;
+			size_t first = levelBegin + size * worker / threads;
+			size_t last = levelBegin + size * (worker + 1) / threads;
+			uint64_t level = uint64_t(depth) << 32;
+
+			if (deterministic) {
+				for (size_t i = first; i < last; ++i) {
+					VertexId vertex = order[i];
+					for (uint32_t e = edgesBegin(vertex);
+						e < edgesEnd(vertex); ++e) {
+						if (!isReached(targets[e])) {
+							atomicMin(claims[targets[e]],
+								level | (i - levelBegin));
+						}
+					}
+				}
+				barrier.wait();
+			}
+
+			for (size_t i = first; i < last; ++i) {
+				VertexId vertex = order[i];
+				for (uint32_t e = edgesBegin(vertex); e < edgesEnd(vertex);
+					++e) {
+					VertexId neighbor = targets[e];
+					bool mineToTake = deterministic ?
+						claims[neighbor].load(std::memory_order_relaxed) ==
+						(level | (i - levelBegin)) :
+						!isReached(neighbor);
+					if (mineToTake && reach(neighbor)) {
+						hops[neighbor] = depth + 1;
+						parent[neighbor] = vertex;
+						mine.push_back(neighbor);
+					}
+				}
+			}
+			barrier.wait();
+
+			// buffers go into order by thread number, no lock needed
+			// as each thread copies to its own range
+			size_t at = levelEnd;
+			size_t total = 0;
+			for (unsigned other = 0; other < threads; ++other) {
+				if (other < worker) {
+					at += found[other].size();
+				}
+				total += found[other].size();
+			}
+			std::copy(mine.begin(), mine.end(), order.begin() + at);
+			barrier.wait();
+
+			mine.clear();
+			levelBegin = levelEnd;
+			levelEnd += total;
+		}
+		if (worker == 0) {
+			numReached = levelEnd;
+		}
+	};
+
+	std::vector<std::thread> workers;
+	for (unsigned worker = 1; worker < threads; ++worker) {
+		workers.emplace_back(search, worker);
+	}
+	search(0);
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+	order.resize(numReached);
+}
+
+/** True if target can be reached from source
+breadth-first search that stops as soon as target is found */
+template <typename Weight, typename VertexId>
+bool BasicCsrGraph<Weight, VertexId>::isReachable(VertexId source,
+	VertexId target,
+	Workspace& workspace) const
+{
+	if (source == target) {
+		return true;
+	}
+
+	BasicVertexMarks<Cost, VertexId>& visited = workspace.forward;
+	visited.reset(numVertices);
+	std::vector<VertexId>& bft = workspace.queue;
+	bft.clear();
+	bft.push_back(source);
+	visited.reach(source);
+
+	for (size_t head = 0; head < bft.size(); ++head) {
+		VertexId vertex = bft[head];
+		for (uint32_t e = edgesBegin(vertex); e < edgesEnd(vertex); ++e) {
+			VertexId neighbor = targets[e];
+			if (neighbor == target) {
+				return true;
+			}
+			if (!visited.isReached(neighbor)) {
+				visited.reach(neighbor);
+				bft.push_back(neighbor);
+			}
+		}
+	}
+	return false;
+}
+
+/** Dijkstra's shortest-path algorithm from vertex source
+binary heap with lazy deletion over flat arrays indexed by id */
+template <typename Weight, typename VertexId>
+void BasicCsrGraph<Weight, VertexId>::shortestPathTree(VertexId source,
+	std::vector<Cost>& cost, std::vector<VertexId>& parent) const
+{
+	Workspace workspace;
+	shortestPathTree(source, cost, parent, workspace);
+}
+
+/** shortestPathTree using the heap, levels or buckets of workspace */
+template <typename Weight, typename VertexId>
+void BasicCsrGraph<Weight, VertexId>::shortestPathTree(VertexId source,
+	std::vector<Cost>& cost, std::vector<VertexId>& parent,
+	Workspace& workspace) const
+{
+	SearchStats& stats = workspace.stats;
+	stats.clear();
+	cost.assign(numVertices, UNREACHABLE);
+	parent.assign(numVertices, NO_VERTEX);
+	stats.phase(SearchPhase::SEARCH);
+
+	cost[source] = 0;
+	bool queued = false;
+	if (useLevels()) {
+		LevelQueue<Cost, VertexId> queue(workspace.queue,
+			workspace.nextQueue, workspace.sameLevel);
+		queue.push(0, source);
+		growTree(queue, cost, parent, stats);
+		queued = true;
+	}
+	if constexpr (std::is_integral<Weight>::value) {
+		if (!queued && useBuckets()) {
+			BucketQueue<Cost, VertexId> queue(workspace.buckets,
+				static_cast<uint64_t>(weightProfile.getMaxWeight()));
+			queue.push(0, source);
+			growTree(queue, cost, parent, stats);
+			queued = true;
+		}
+	}
+	if (!queued) {
+		BinaryHeap<Cost, VertexId> queue(workspace.heap[0]);
+		queue.push(0, source);
+		growTree(queue, cost, parent, stats);
+	}
+	stats.stop();
+}
+
+/** settle every vertex reachable from the vertex in queue */
+template <typename Weight, typename VertexId>
+template <typename Queue>
+void BasicCsrGraph<Weight, VertexId>::growTree(Queue& queue,
+	std::vector<Cost>& cost, std::vector<VertexId>& parent,
+	SearchStats& stats) const
+{
+	stats.push(queue.size());
+	while (!queue.empty()) {
+		typename Queue::Entry smallest = queue.pop();
+		stats.pop();
+		VertexId vertex = smallest.second;
+
+		// stale entry, a cheaper path was found after it was pushed
+		if (smallest.first > cost[vertex]) {
+			stats.stale();
+			continue;
+		}
+
+		stats.settle();
+		stats.scan(edgesEnd(vertex) - edgesBegin(vertex));
+		for (uint32_t e = edgesBegin(vertex); e < edgesEnd(vertex); ++e) {
+			VertexId neighbor = targets[e];
+			Cost challenger = WeightTraits<Weight>::add(smallest.first,
+				weights[e]);
+			if (challenger < cost[neighbor]) {
+				cost[neighbor] = challenger;
+				parent[neighbor] = vertex;
+				queue.push(challenger, neighbor);
+				stats.push(queue.size());
+			}
+		}
+	}
+}
+
+/** same cost and parent as shortestPathTree, by parallel delta-stepping
+Rounds alternate between threads sending requests for the edges of the
+vertices they own and applying the requests sent to them. A request
+that ties the cost of a vertex takes over as its parent if it comes
+from a cheaper, or equally cheap and lower, vertex, which is the
+vertex Dijkstra settles first. Over a zero-weight edge it only does so
+in the round the cost was set, so parents cannot form a cycle. */
+template <typename Weight, typename VertexId>
+void BasicCsrGraph<Weight, VertexId>::deltaSteppingTree(VertexId source,
+	std::vector<Cost>& cost, std::vector<VertexId>& parent, Cost delta,
+	unsigned threads) const
+{
+	if (threads == 0) {
+		threads = std::max(1u, std::thread::hardware_concurrency());
+	}
+	if (!(delta > 0)) {
+		double total = 0;
+		for (uint32_t e = 0; e < numEdges; ++e) {
+			total += static_cast<double>(weights[e]);
+		}
+		delta = numEdges == 0 ? 0 : static_cast<Cost>(total / numEdges);
+		if (!(delta > 0)) {
+			delta = 1;
+		}
+	}
+
+	cost.assign(numVertices, UNREACHABLE);
+	parent.assign(numVertices, NO_VERTEX);
+
+	// only the owner of a vertex reads or writes these for it
+	const size_t NO_BUCKET = SIZE_MAX;
+	std::vector<Cost> parentCost(numVertices, UNREACHABLE);
+	std::vector<uint32_t> costRound(numVertices, 0);
+	std::vector<size_t> queuedIn(numVertices, NO_BUCKET);
+	std::vector<size_t> settledIn(numVertices, NO_BUCKET);
+
+	/** target can be reached at cost through from */
+	struct Request {
+		VertexId target;
+		VertexId from;
+		Cost cost;
+		Cost fromCost;
+	};
+	// requests[sender * threads + owner], only the sender adds and only
+	// the owner reads and clears, with a barrier in between
+	std::vector<std::vector<Request>> requests(size_t(threads) * threads);
+
+	// two sets of slots, so a value can be published while the last
+	// one is still being read
+	std::vector<size_t> published(2 * size_t(threads));
+	Barrier barrier(threads);
+
+	auto bucketOf = [delta](Cost c) {
+		return static_cast<size_t>(c / delta);
+	};
+	auto ownerOf = [threads](VertexId v) { return v % threads; };
+
+	auto search = [&](unsigned me) {
+		std::map<size_t, std::vector<VertexId>> buckets;
+		std::vector<VertexId> taken;
+		std::vector<VertexId> settled;
+		uint32_t round = 1;
+		size_t slot = 0;
+
+		// every thread gets the smallest value any thread published
+		auto agree = [&](size_t value) {
+			size_t* slots = published.data() + slot * threads;
+			slots[me] = value;
+			barrier.wait();
+			slot = 1 - slot;
+			return *std::min_element(slots, slots + threads);
+		};
+		auto enqueue = [&](VertexId v) {
+			size_t bucket = bucketOf(cost[v]);
+			if (queuedIn[v] != bucket) {
+				buckets[bucket].push_back(v);
+				queuedIn[v] = bucket;
+			}
+		};
+		auto firstBucket = [&]() {
+			return buckets.empty() ? NO_BUCKET : buckets.begin()->first;
+		};
+		auto send = [&](VertexId vertex, bool light) {
+			for (uint32_t e = edgesBegin(vertex); e < edgesEnd(vertex); ++e) {
+				if ((weights[e] <= delta) != light) {
+					continue;
+				}
+				Cost challenger = WeightTraits<Weight>::add(cost[vertex],
+					weights[e]);
+				if (challenger != UNREACHABLE) {
+					requests[size_t(me) * threads + ownerOf(targets[e])]
+						.push_back(Request{ targets[e], vertex, challenger,
+							cost[vertex] });
+				}
+			}
+		};
+		auto apply = [&]() {
+			for (unsigned sender = 0; sender < threads; ++sender) {
+				std::vector<Request>& inbox =
+					requests[size_t(sender) * threads + me];
+				for (const Request& request : inbox) {
+					VertexId v = request.target;
+					if (request.cost < cost[v]) {
+						cost[v] = request.cost;
+						parent[v] = request.from;
+						parentCost[v] = request.fromCost;
+						costRound[v] = round;
+						enqueue(v);
+					}
+					else if (request.cost == cost[v] &&
+						(request.fromCost < request.cost ||
+							costRound[v] == round) &&
+						std::make_pair(request.fromCost, request.from) <
+						std::make_pair(parentCost[v], parent[v])) {
+						parent[v] = request.from;
+						parentCost[v] = request.fromCost;
+					}
+				}
+				inbox.clear();
+			}
+			++round;
+		};
+
+		if (ownerOf(source) == me) {
+			cost[source] = 0;
+			parentCost[source] = 0;
+			enqueue(source);
+		}
+
+		size_t current = agree(firstBucket());
+		while (current != NO_BUCKET) {
+			// light edges until no vertex is left in the bucket
+			settled.clear();
+			do {
+				taken.clear();
+				auto it = buckets.find(current);
+				if (it != buckets.end()) {
+					taken.swap(it->second);
+					buckets.erase(it);
+				}
+				for (VertexId v : taken) {
+					// moved to a lower bucket after it was put in
+					if (queuedIn[v] != current) {
+						continue;
+					}
+					queuedIn[v] = NO_BUCKET;
+					if (settledIn[v] != current) {
+						settledIn[v] = current;
+						settled.push_back(v);
+					}
+					send(v, true);
+				}
+				barrier.wait();
+				apply();
+			} while (agree(buckets.count(current) ? current : NO_BUCKET) !=
+				NO_BUCKET);
+
+			// heavy edges lead past the bucket, once is enough
+			for (VertexId v : settled) {
+				send(v, false);
+			}
+			barrier.wait();
+			apply();
+			current = agree(firstBucket());
+		}
+	};
+
+	std::vector<std::thread> workers;
+	for (unsigned worker = 1; worker < threads; ++worker) {
+		workers.emplace_back(search, worker);
+	}
+	search(0);
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+}
+
+/** lowest cost from source to target, UNREACHABLE if unreachable
+Dijkstra that stops as soon as target is settled
+path is filled with the vertices from source to target */
+template <typename Weight, typename VertexId>
+typename BasicCsrGraph<Weight, VertexId>::Cost
+BasicCsrGraph<Weight, VertexId>::shortestPath(
+	VertexId source, VertexId target, std::vector<VertexId>& path) const
+{
+	Workspace workspace;
+	return shortestPath(source, target, path, workspace);
+}
+
+/** shortestPath keeping its state in workspace */
+template <typename Weight, typename VertexId>
+typename BasicCsrGraph<Weight, VertexId>::Cost
+BasicCsrGraph<Weight, VertexId>::shortestPath(
+	VertexId source, VertexId target, std::vector<VertexId>& path,
+	Workspace& workspace) const
+{
+	path.clear();
+
+	SearchStats& stats = workspace.stats;
+	stats.clear();
+	BasicVertexMarks<Cost, VertexId>& marks = workspace.forward;
+	marks.reset(numVertices);
+	stats.phase(SearchPhase::SEARCH);
+
+	marks.setCost(source, 0, NO_VERTEX);
+	bool queued = false;
+	if (useLevels()) {
+		LevelQueue<Cost, VertexId> queue(workspace.queue,
+			workspace.nextQueue, workspace.sameLevel);
+		queue.push(0, source);
+		growTo(target, queue, marks, stats);
+		queued = true;
+	}
+	if constexpr (std::is_integral<Weight>::value) {
+		if (!queued && useBuckets()) {
+			BucketQueue<Cost, VertexId> queue(workspace.buckets,
+				static_cast<uint64_t>(weightProfile.getMaxWeight()));
+			queue.push(0, source);
+			growTo(target, queue, marks, stats);
+			queued = true;
+		}
+	}
+	if (!queued) {
+		BinaryHeap<Cost, VertexId> queue(workspace.heap[0]);
+		queue.push(0, source);
+		growTo(target, queue, marks, stats);
+	}
+
+	if (!marks.isReached(target)) {
+		stats.stop();
+		return UNREACHABLE;
+	}
+
+	stats.phase(SearchPhase::OUTPUT);
+	for (VertexId v = target; v != NO_VERTEX; v = marks.getParent(v)) {
+		path.push_back(v);
+	}
+	std::reverse(path.begin(), path.end());
+	stats.stop();
+	return marks.getCost(target);
+}
+
+/** settle vertices from the vertex in queue until target is settled */
+template <typename Weight, typename VertexId>
+template <typename Queue>
+void BasicCsrGraph<Weight, VertexId>::growTo(VertexId target, Queue& queue,
+	BasicVertexMarks<Cost, VertexId>& marks, SearchStats& stats) const
+{
+	stats.push(queue.size());
+	while (!queue.empty()) {
+		typename Queue::Entry smallest = queue.pop();
+		stats.pop();
+		VertexId vertex = smallest.second;
+
+		if (smallest.first > marks.getCost(vertex)) {
+			stats.stale();
+			continue;
+		}
+
+		// target is settled, no cheaper path can be found
+		stats.settle();
+		if (vertex == target) {
+			return;
+		}
+
+		stats.scan(edgesEnd(vertex) - edgesBegin(vertex));
+		for (uint32_t e = edgesBegin(vertex); e < edgesEnd(vertex); ++e) {
+			VertexId neighbor = targets[e];
+			Cost challenger = WeightTraits<Weight>::add(smallest.first,
+				weights[e]);
+			if (challenger < marks.getCost(neighbor)) {
+				marks.setCost(neighbor, challenger, vertex);
+				queue.push(challenger, neighbor);
+				stats.push(queue.size());
+			}
+		}
+	}
+}
+
+/** same result as shortestPath, searches forward from source and
+backward from target over the incoming edges at the same time
+and stops once the two searches cannot find a cheaper path */
+template <typename Weight, typename VertexId>
+typename BasicCsrGraph<Weight, VertexId>::Cost
+BasicCsrGraph<Weight, VertexId>::bidirectionalShortestPath(VertexId source,
+	VertexId target, std::vector<VertexId>& path) const
+{
+	Workspace workspace;
+	return bidirectionalShortestPath(source, target, path, workspace);
+}
+
+/** bidirectionalShortestPath keeping its state in workspace */
+template <typename Weight, typename VertexId>
+typename BasicCsrGraph<Weight, VertexId>::Cost
+BasicCsrGraph<Weight, VertexId>::bidirectionalShortestPath(VertexId source,
+	VertexId target, std::vector<VertexId>& path,
+	Workspace& workspace) const
+{
+	typedef typename Workspace::HeapEntry HeapEntry;
+	path.clear();
+	if (source == target) {
+		path.push_back(source);
+		return 0;
+	}
+
+	// index 0 is the forward search, index 1 the backward search
+	// the parent of v in the backward search is the vertex after v
+	// on the way to target
+	BasicVertexMarks<Cost, VertexId>* marks[2] = { &workspace.forward,
+		&workspace.backward };
+	std::vector<HeapEntry>* pq[2] = { &workspace.heap[0],
+		&workspace.heap[1] };
+
+	for (int side = 0; side < 2; ++side) {
+		marks[side]->reset(numVertices);
+		pq[side]->clear();
+	}
+	marks[0]->setCost(source, 0, NO_VERTEX);
+	marks[1]->setCost(target, 0, NO_VERTEX);
+	pushHeap(*pq[0], HeapEntry(0, source));
+	pushHeap(*pq[1], HeapEntry(0, target));
+
+	// cheapest path found so far and where the two searches met
+	Cost best = UNREACHABLE;
+	VertexId meet = NO_VERTEX;
+
+	while (!pq[0]->empty() && !pq[1]->empty()) {
+		// every path not yet seen costs at least the two smallest
+		// entries added together
+		if (WeightTraits<Weight>::add(pq[0]->front().first,
+			pq[1]->front().first) >= best) {
+			break;
+		}
+
+		// grow the search with fewer entries waiting
+		int side = pq[0]->size() <= pq[1]->size() ? 0 : 1;
+		HeapEntry smallest = popHeap(*pq[side]);
+		VertexId vertex = smallest.second;
+
+		if (smallest.first > marks[side]->getCost(vertex)) {
+			continue;
+		}
+
+		uint32_t first = side == 0 ? edgesBegin(vertex)
+			: reverseEdgesBegin(vertex);
+		uint32_t last = side == 0 ? edgesEnd(vertex)
+			: reverseEdgesEnd(vertex);
+		const VertexId* ends = side == 0 ? targets : sources;
+		const Weight* costs = side == 0 ? weights : reverseWeights;
+
+		for (uint32_t e = first; e < last; ++e) {
+			VertexId neighbor = ends[e];
+			Cost challenger = WeightTraits<Weight>::add(smallest.first,
+				costs[e]);
+			if (challenger < marks[side]->getCost(neighbor)) {
+				marks[side]->setCost(neighbor, challenger, vertex);
+				pushHeap(*pq[side], HeapEntry(challenger, neighbor));
+			}
+
+			// the other search has reached neighbor already
+			Cost other = marks[1 - side]->getCost(neighbor);
+			Cost through = WeightTraits<Weight>::add(
+				marks[side]->getCost(neighbor), other);
+			if (other != UNREACHABLE && through < best) {
+				best = through;
+				meet = neighbor;
+			}
+		}
+	}
+
+	if (meet == NO_VERTEX) {
+		return UNREACHABLE;
+	}
+
+	for (VertexId v = meet; v != NO_VERTEX; v = marks[0]->getParent(v)) {
+		path.push_back(v);
+	}
+	std::reverse(path.begin(), path.end());
+	for (VertexId v = marks[1]->getParent(meet); v != NO_VERTEX;
+		v = marks[1]->getParent(v)) {
+		path.push_back(v);
+	}
+	return best;
+}
+
+/** find the lowest cost from startLabel to all vertices that
+can be reached, same output as Graph::djikstraCostToAllVertices
+adapter that copies the result of shortestPathTree into maps */
+template <typename Weight, typename VertexId>
+void BasicCsrGraph<Weight, VertexId>::djikstraCostToAllVertices(
+	std::string_view startLabel, std::map<std::string, Cost>& weight,
+	std::map<std::string, std::string>& previous) const
+{
+	Workspace workspace;
+	djikstraCostToAllVertices(startLabel, weight, previous, workspace);
+}
+
+/** djikstraCostToAllVertices keeping its state in workspace
+the copy into the maps is timed as the OUTPUT phase */
+template <typename Weight, typename VertexId>
+void BasicCsrGraph<Weight, VertexId>::djikstraCostToAllVertices(
+	std::string_view startLabel, std::map<std::string, Cost>& weight,
+	std::map<std::string, std::string>& previous,
+	Workspace& workspace) const
+{
+	weight.clear();
+	previous.clear();
+
+	VertexId start = findVertex(startLabel);
+	if (start == NO_VERTEX) {
+		workspace.stats.clear();
+		workspace.stats.stop();
+		return;
+	}
+
+	std::vector<Cost> cost;
+	std::vector<VertexId> parent;
+	shortestPathTree(start, cost, parent, workspace);
+
+	workspace.stats.phase(SearchPhase::OUTPUT);
+	treeToMaps(cost, parent, weight, previous);
+	workspace.stats.stop();
+}
+
+/** djikstraCostToAllVertices using deltaSteppingTree */
+template <typename Weight, typename VertexId>
+void BasicCsrGraph<Weight, VertexId>::deltaSteppingCostToAllVertices(
+	std::string_view startLabel, std::map<std::string, Cost>& weight,
+	std::map<std::string, std::string>& previous, Cost delta,
+	unsigned threads) const
+{
+	weight.clear();
+	previous.clear();
+
+	VertexId start = findVertex(startLabel);
+	if (start == NO_VERTEX) {
+		return;
+	}
+
+	std::vector<Cost> cost;
+	std::vector<VertexId> parent;
+	deltaSteppingTree(start, cost, parent, delta, threads);
+	treeToMaps(cost, parent, weight, previous);
+}
+
+/** fill weight and previous from the result of a tree search
+the start vertex has no parent and is left out, like every vertex
+that cannot be reached */
+template <typename Weight, typename VertexId>
+void BasicCsrGraph<Weight, VertexId>::treeToMaps(
+	const std::vector<Cost>& cost, const std::vector<VertexId>& parent,
+	std::map<std::string, Cost>& weight,
+	std::map<std::string, std::string>& previous) const
+{
+	// ids are in label order, so every insert goes at the end
+	for (VertexId v = 0; v < numVertices; ++v) {
+		if (parent[v] != NO_VERTEX) {
+			weight.emplace_hint(weight.end(), getLabel(v), cost[v]);
+			previous.emplace_hint(previous.end(), getLabel(v),
+				getLabel(parent[v]));
+		}
+	}
+}
+
+// the weight and id types listed in graph.cpp
+template class BasicCsrGraph<int, uint32_t>;
+template class BasicCsrGraph<uint16_t, uint16_t>;
+template class BasicCsrGraph<uint32_t, uint32_t>;
+template class BasicCsrGraph<int64_t, uint32_t>;
+template class BasicCsrGraph<float, uint32_t>;
@@ -0,0 +1,659 @@
+/**
+* Compressed sparse row (CSR) snapshot of a Graph
+* Every vertex is given a dense VertexId. Ids are handed out in label
+* order, so the neighbors of a vertex are stored in the same alphabetical
+* order the Graph uses and the traversals visit vertices in the same order.
+* The outgoing edges of vertex v are stored at positions
+* offsets[v] .. offsets[v + 1] - 1 of the targets and weights arrays.
+* A snapshot is immutable, later changes to the Graph are not reflected.
+* All arrays live in one block laid out exactly like the binary file
+* written by saveBinary, so openBinary only has to map the file. Copies
+* of a snapshot share that block.
+* Every const function only reads the arrays, so any number of threads
+* can query one snapshot at the same time as long as each thread uses
+* its own workspace.
+* Weight is the type of the edge weights, see weighttraits.h. Narrow
+* weight and id types shrink the edge arrays, CsrGraph is the snapshot
+* of the default Graph.
+*/
+
+#ifndef CSRGRAPH_H
+#define CSRGRAPH_H
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "searchworkspace.h"
+#include "weightprofile.h"
+#include "weighttraits.h"
+
+template <typename Weight, typename VertexId>
+class BasicGraph;
+
+/** returned by a traversal visitor to say how the traversal goes on
+CONTINUE explores the neighbors of the vertex just visited, SKIP goes on
+without them and STOP ends the traversal */
+enum class Visit { CONTINUE, STOP, SKIP };
+
+template <typename Weight, typename VertexId>
+class BasicCsrGraph {
+public:
+	/** type path costs are added up in */
+	typedef typename WeightTraits<Weight>::Cost Cost;
+
+	/** per-query state for searches on this graph */
+	typedef BasicSearchWorkspace<Cost, VertexId> Workspace;
+
+	/** returned by findVertex if the label does not exist */
+	static constexpr VertexId NO_VERTEX =
+		std::numeric_limits<VertexId>::max();
+
+	/** cost of a vertex that cannot be reached */
+	static constexpr Cost UNREACHABLE = WeightTraits<Weight>::UNREACHABLE;
+
+	/** returned by getEdgeWeight for an edge that does not exist */
+	static constexpr Weight NO_EDGE = WeightTraits<Weight>::NO_EDGE;
+
+	/** largest edge weight the shortest-path searches use a bucket
+	queue for, integer weights only */
+	static constexpr uint64_t MAX_BUCKET_WEIGHT = 1 << 12;
+
+	/** most edges a snapshot can have, the edge offsets are uint32_t */
+	static constexpr uint64_t MAX_EDGES =
+		std::numeric_limits<uint32_t>::max() - 1;
+
+	/** hops to a vertex breadthFirstTree did not reach */
+	static constexpr uint32_t NO_HOPS =
+		std::numeric_limits<uint32_t>::max();
+
+	/** constructor, empty graph */
+	BasicCsrGraph();
+
+	/** constructor, copies the vertices and edges of graph
+	a graph of more than MAX_EDGES edges, which Graph never lets grow,
+	gives an empty snapshot, like openBinary refusing such a file */
+	explicit BasicCsrGraph(const BasicGraph<Weight, VertexId>& graph);
+
+	/** write the snapshot to filename in the binary snapshot format
+	@return  True if the whole file was written. */
+	bool saveBinary(const std::string& filename) const;
+
+	/** replace this snapshot with one written by saveBinary
+	the file is mapped and queries read the mapped arrays directly
+	With check every offset array is checked to never go down and
+	every vertex id in the edge arrays to be a vertex, one pass over
+	the offsets and ids. Without it only the header and the last
+	offsets are checked, so opening takes the same time for any size,
+	and the file must be trusted: a damaged one makes queries read out
+	of bounds.
+	@return  False, leaving this snapshot as it was, if the file
+	cannot be opened, is not a snapshot of this version with these
+	weight and id types or fails the checks. */
+	bool openBinary(const std::string& filename, bool check = true);
+
+	/** return number of vertices */
+	int getNumVertices() const;
+
+	/** return number of edges */
+	int getNumEdges() const;
+
+	/** return the smallest edge weight, 0 if there are no edges */
+	Weight getMinWeight() const { return weightProfile.getMinWeight(); }
+
+	/** return the largest edge weight, 0 if there are no edges */
+	Weight getMaxWeight() const { return weightProfile.getMaxWeight(); }
+
+	/** return how the edge weights are spread, see weightprofile.h */
+	const WeightProfile<Weight>& getWeightProfile() const
+	{
+		return weightProfile;
+	}
+
+	/** return the id of the vertex with the given label
+	returns NO_VERTEX if the vertex does not exist */
+	VertexId findVertex(std::string_view vertexLabel) const;
+
+	/** return the label of the vertex with the given id */
+	std::string_view getLabel(VertexId id) const;
+
+	/** index of the first outgoing edge of vertex id */
+	uint32_t edgesBegin(VertexId id) const { return offsets[id]; }
+
+	/** index one past the last outgoing edge of vertex id */
+	uint32_t edgesEnd(VertexId id) const { return offsets[id + 1]; }
+
+	/** the vertex edge e connects to */
+	VertexId getTarget(uint32_t e) const { return targets[e]; }
+
+	/** the weight/cost of travelling via edge e */
+	Weight getWeight(uint32_t e) const { return weights[e]; }
+
+	/** index of the first incoming edge of vertex id */
+	uint32_t reverseEdgesBegin(VertexId id) const
+	{
+		return reverseOffsets[id];
+	}
+
+	/** index one past the last incoming edge of vertex id */
+	uint32_t reverseEdgesEnd(VertexId id) const
+	{
+		return reverseOffsets[id + 1];
+	}
+
+	/** the vertex incoming edge e starts from */
+	VertexId getSource(uint32_t e) const { return sources[e]; }
+
+	/** the weight/cost of travelling via incoming edge e */
+	Weight getReverseWeight(uint32_t e) const { return reverseWeights[e]; }
+
+	/** return weight of the edge between start and end
+	returns NO_EDGE if not connected or vertices don't exist */
+	Weight getEdgeWeight(std::string_view start, std::string_view end) const;
+
+	/** depth-first traversal starting from startLabel
+	call the function visit on each vertex label */
+	void depthFirstTraversal(std::string_view startLabel,
+		void visit(const std::string&)) const;
+
+	/** depth-first traversal keeping its state in workspace
+	reusing a workspace avoids clearing per-vertex state */
+	void depthFirstTraversal(std::string_view startLabel,
+		void visit(const std::string&), Workspace& workspace) const;
+
+	/** breadth-first traversal starting from startLabel
+	call the function visit on each vertex label */
+	void breadthFirstTraversal(std::string_view startLabel,
+		void visit(const std::string&)) const;
+
+	/** breadth-first traversal keeping its state in workspace */
+	void breadthFirstTraversal(std::string_view startLabel,
+		void visit(const std::string&), Workspace& workspace) const;
+
+	/** depth-first traversal from vertex start, in the same order
+	visit(id, depth) is called on each vertex, depth is the number of
+	tree edges from start. It returns a Visit, or nothing to always
+	continue. Any callable works and is inlined.
+	@return  False if visit stopped the traversal. */
+	template <typename Visitor>
+	bool depthFirstTraversal(VertexId start, Visitor&& visit) const;
+
+	/** depth-first traversal with a visitor keeping its state in
+	workspace */
+	template <typename Visitor>
+	bool depthFirstTraversal(VertexId start, Visitor&& visit,
+		Workspace& workspace) const;
+
+	/** breadth-first traversal from vertex start, in the same order
+	visit(id, depth) is called on each vertex, depth is the number of
+	edges on the shortest path from start, see depthFirstTraversal
+	@return  False if visit stopped the traversal. */
+	template <typename Visitor>
+	bool breadthFirstTraversal(VertexId start, Visitor&& visit) const;
+
+	/** breadth-first traversal with a visitor keeping its state in
+	workspace */
+	template <typename Visitor>
+	bool breadthFirstTraversal(VertexId start, Visitor&& visit,
+		Workspace& workspace) const;
+
+	/** level-synchronous breadth-first search from vertex source
+	hops[v] is the number of edges on the shortest path to v, NO_HOPS
+	if unreachable, parent[v] is a vertex one hop closer to source,
+	NO_VERTEX for source and unreachable vertices
+	each level is expanded top-down from the frontier, or bottom-up by
+	checking the incoming edges of every vertex not yet reached,
+	whichever the Beamer heuristic expects to scan fewer edges */
+	void breadthFirstTree(VertexId source, std::vector<uint32_t>& hops,
+		std::vector<VertexId>& parent) const;
+
+	/** breadthFirstTree keeping its frontier in workspace, the counters
+	of the search go to workspace.stats */
+	void breadthFirstTree(VertexId source, std::vector<uint32_t>& hops,
+		std::vector<VertexId>& parent, Workspace& workspace) const;
+
+	/** breadthFirstTree with each level split over threads threads,
+	0 uses every core
+	order is filled with the vertices in the order they were reached.
+	Each thread puts the vertices it reaches in its own buffer, the
+	buffers are copied one after the other into order.
+	deterministic gives the order and parents of breadthFirstTraversal,
+	the first vertex of a level with an edge to a vertex is its parent.
+	Otherwise the thread that marks a vertex first makes it its child,
+	the hops are the same but parents and the order within a level
+	change from run to run. A level costs a few thread handoffs, so
+	this pays off on large graphs with few levels. */
+	void parallelBreadthFirstTree(VertexId source,
+		std::vector<uint32_t>& hops, std::vector<VertexId>& parent,
+		std::vector<VertexId>& order, unsigned threads = 0,
+		bool deterministic = false) const;
+
+	/** True if target can be reached from source
+	breadth-first search that stops as soon as target is found */
+	bool isReachable(VertexId source, VertexId target,
+		Workspace& workspace) const;
+
+	/** Dijkstra's shortest-path algorithm from vertex source
+	binary heap with lazy deletion over flat arrays indexed by id.
+	The queue is picked from the weight profile, all of them settle
+	vertices in the same order:
+	every weight the same   breadth-first search level by level
+	every weight 0 or 1     0-1 BFS
+	integers up to MAX_BUCKET_WEIGHT   Dial's bucket queue
+	cost[v] is the lowest cost to reach v, UNREACHABLE if unreachable
+	parent[v] is the vertex before v on that path, NO_VERTEX for
+	source and unreachable vertices */
+	void shortestPathTree(VertexId source, std::vector<Cost>& cost,
+		std::vector<VertexId>& parent) const;
+
+	/** shortestPathTree using the heap of workspace, the counters of
+	the search go to workspace.stats */
+	void shortestPathTree(VertexId source, std::vector<Cost>& cost,
+		std::vector<VertexId>& parent, Workspace& workspace) const;
+
+	/** same cost and parent as shortestPathTree, found by parallel
+	delta-stepping over threads threads, 0 uses every core
+	vertices wait in buckets delta wide, delta 0 uses the average edge
+	weight. Edges no heavier than delta are light and relaxed again
+	while the bucket refills, heavy edges once when it is empty.
+	Each thread owns the vertices v with v % threads equal to its
+	number and only it changes their cost, other threads send it
+	requests. With zero-weight edges a parent may be another vertex
+	with the same cheapest cost. */
+	void deltaSteppingTree(VertexId source, std::vector<Cost>& cost,
+		std::vector<VertexId>& parent, Cost delta = 0,
+		unsigned threads = 0) const;
+
+	/** lowest cost from source to target, UNREACHABLE if unreachable
+	Dijkstra that stops as soon as target is settled
+	path is filled with the vertices from source to target */
+	Cost shortestPath(VertexId source, VertexId target,
+		std::vector<VertexId>& path) const;
+
+	/** shortestPath keeping its state in workspace, with a reused
+	workspace the cost only depends on the vertices reached */
+	Cost shortestPath(VertexId source, VertexId target,
+		std::vector<VertexId>& path, Workspace& workspace) const;
+
+	/** same result as shortestPath, searches forward from source and
+	backward from target over the incoming edges at the same time
+	and stops once the two searches cannot find a cheaper path */
+	Cost bidirectionalShortestPath(VertexId source, VertexId target,
+		std::vector<VertexId>& path) const;
+
+	/** bidirectionalShortestPath keeping its state in workspace */
+	Cost bidirectionalShortestPath(VertexId source, VertexId target,
+		std::vector<VertexId>& path, Workspace& workspace) const;
+
+	/** same cost as shortestPath, A* search guided by heuristic
+	heuristic(v) returns a lower bound on the cost from v to target.
+	It must be consistent, never more than the weight of an edge v - w
+	plus heuristic(w), so each vertex is settled once. UNREACHABLE
+	says target cannot be reached from v, v is then left out.
+	A heuristic that returns 0 searches like shortestPath. When there
+	are several cheapest paths the one found may differ. */
+	template <typename Heuristic>
+	Cost aStarPath(VertexId source, VertexId target,
+		std::vector<VertexId>& path, Heuristic&& heuristic) const;
+
+	/** aStarPath keeping its state in workspace */
+	template <typename Heuristic>
+	Cost aStarPath(VertexId source, VertexId target,
+		std::vector<VertexId>& path, Heuristic&& heuristic,
+		Workspace& workspace) const;
+
+	/** find the lowest cost from startLabel to all vertices that
+	can be reached, same output as Graph::djikstraCostToAllVertices
+	adapter that copies the result of shortestPathTree into maps */
+	void djikstraCostToAllVertices(
+		std::string_view startLabel,
+		std::map<std::string, Cost>& weight,
+		std::map<std::string, std::string>& previous) const;
+
+	/** djikstraCostToAllVertices keeping its state in workspace */
+	void djikstraCostToAllVertices(
+		std::string_view startLabel,
+		std::map<std::string, Cost>& weight,
+		std::map<std::string, std::string>& previous,
+		Workspace& workspace) const;
+
+	/** djikstraCostToAllVertices using deltaSteppingTree, same maps */
+	void deltaSteppingCostToAllVertices(
+		std::string_view startLabel,
+		std::map<std::string, Cost>& weight,
+		std::map<std::string, std::string>& previous, Cost delta = 0,
+		unsigned threads = 0) const;
+
+	/** add the cost and parent of every vertex a tree search reached,
+	except the source, to weight and previous by label */
+	void treeToMaps(const std::vector<Cost>& cost,
+		const std::vector<VertexId>& parent,
+		std::map<std::string, Cost>& weight,
+		std::map<std::string, std::string>& previous) const;
+
+private:
+	/** keeps the block the arrays point into alive, either memory
+	owned by the snapshot or a mapped file */
+	std::shared_ptr<const void> storage;
+
+	/** first byte of the snapshot block, the Header */
+	const char* block{ nullptr };
+
+	/** number of vertices */
+	uint32_t numVertices{ 0 };
+
+	/** number of edges */
+	uint32_t numEdges{ 0 };
+
+	/** how the edge weights are spread, taken from the Graph and kept
+	in the header, so opening a file does not read the weights */
+	WeightProfile<Weight> weightProfile;
+
+	/** label of vertex v is labelBytes[labelOffsets[v]] up to
+	labelBytes[labelOffsets[v + 1]], labels are sorted */
+	const uint64_t* labelOffsets{ nullptr };
+
+	/** every label, one after the other */
+	const char* labelBytes{ nullptr };
+
+	/** offsets[v] is the index of the first edge of vertex v,
+	has one entry more than there are vertices */
+	const uint32_t* offsets{ nullptr };
+
+	/** end vertex of every edge, grouped by start vertex */
+	const VertexId* targets{ nullptr };
+
+	/** weight of every edge, parallel to targets */
+	const Weight* weights{ nullptr };
+
+	/** the same edges grouped by end vertex, used to search backward
+	reverseOffsets[v] is the index of the first edge into vertex v */
+	const uint32_t* reverseOffsets{ nullptr };
+
+	/** start vertex of every edge, grouped by end vertex */
+	const VertexId* sources{ nullptr };
+
+	/** weight of every edge, parallel to sources */
+	const Weight* reverseWeights{ nullptr };
+
+	/** point the arrays into the snapshot block starting at base */
+	void attach(const char* base);
+
+	/** True if the weights are all the same or all 0 or 1, and not
+	negative, so a queue of two levels holds every waiting vertex */
+	bool useLevels() const;
+
+	/** True if the weights fit a bucket queue */
+	bool useBuckets() const;
+
+	/** settle every vertex reachable from source, queue holds source */
+	template <typename Queue>
+	void growTree(Queue& queue, std::vector<Cost>& cost,
+		std::vector<VertexId>& parent, SearchStats& stats) const;
+
+	/** settle vertices until target is settled, queue holds source */
+	template <typename Queue>
+	void growTo(VertexId target, Queue& queue,
+		BasicVertexMarks<Cost, VertexId>& marks, SearchStats& stats) const;
+
+	/** call visit on vertex id, CONTINUE if it returns nothing */
+	template <typename Visitor>
+	static Visit callVisitor(Visitor& visit, VertexId id, uint32_t depth);
+};  // end BasicCsrGraph
+
+/** depth-first traversal from vertex start */
+template <typename Weight, typename VertexId>
+template <typename Visitor>
+bool BasicCsrGraph<Weight, VertexId>::depthFirstTraversal(VertexId start,
+	Visitor&& visit) const
+{
+	Workspace workspace;
+	return depthFirstTraversal(start, visit, workspace);
+}
+
+/** depth-first traversal with a visitor keeping its state in workspace */
+template <typename Weight, typename VertexId>
+template <typename Visitor>
+bool BasicCsrGraph<Weight, VertexId>::depthFirstTraversal(VertexId start,
+	Visitor&& visit, Workspace& workspace) const
+{
+	SearchStats& stats = workspace.stats;
+	stats.clear();
+	BasicVertexMarks<Cost, VertexId>& visited = workspace.forward;
+	visited.reset(numVertices);
+	visited.reach(start);
+	stats.phase(SearchPhase::SEARCH);
+
+	stats.settle();
+	Visit next = callVisitor(visit, start, 0);
+	if (next != Visit::CONTINUE) {
+		stats.stop();
+		return next != Visit::STOP;
+	}
+
+	// each entry is a vertex and the next of its edges to look at,
+	// the depth of a vertex is its position on the stack
+	std::vector<std::pair<VertexId, uint32_t>>& dft = workspace.stack;
+	dft.clear();
+	dft.emplace_back(start, edgesBegin(start));
+	stats.frontier(1);
+
+	while (!dft.empty()) {
+		VertexId vertex = dft.back().first;
+		uint32_t& e = dft.back().second;
+
+		// skip neighbors that have already been visited
+		uint32_t first = e;
+		while (e < edgesEnd(vertex) && visited.isReached(targets[e])) {
+			++e;
+		}
+
+		if (e == edgesEnd(vertex)) {
+			stats.scan(e - first);
+			dft.pop_back();
+			continue;
+		}
+
+		VertexId neighbor = targets[e++];
+		stats.scan(e - first);
+		visited.reach(neighbor);
+		stats.settle();
+		next = callVisitor(visit, neighbor,
+			static_cast<uint32_t>(dft.size()));
+		if (next == Visit::STOP) {
+			stats.stop();
+			return false;
+		}
+		if (next == Visit::CONTINUE) {
+			dft.emplace_back(neighbor, edgesBegin(neighbor));
+			stats.frontier(dft.size());
+		}
+	}
+	stats.stop();
+	return true;
+}
+
+/** breadth-first traversal from vertex start */
+template <typename Weight, typename VertexId>
+template <typename Visitor>
+bool BasicCsrGraph<Weight, VertexId>::breadthFirstTraversal(VertexId start,
+	Visitor&& visit) const
+{
+	Workspace workspace;
+	return breadthFirstTraversal(start, visit, workspace);
+}
+
+/** breadth-first traversal with a visitor keeping its state in
+workspace */
+template <typename Weight, typename VertexId>
+template <typename Visitor>
+bool BasicCsrGraph<Weight, VertexId>::breadthFirstTraversal(VertexId start,
+	Visitor&& visit, Workspace& workspace) const
+{
+	SearchStats& stats = workspace.stats;
+	stats.clear();
+	BasicVertexMarks<Cost, VertexId>& visited = workspace.forward;
+	visited.reset(numVertices);
+	stats.phase(SearchPhase::SEARCH);
+
+	// vertices are visited in the order they are added, so a plain
+	// vector with a read position works as the queue. The vertices
+	// of the next depth start where the current depth ends.
+	std::vector<VertexId>& bft = workspace.queue;
+	bft.clear();
+	bft.push_back(start);
+	visited.reach(start);
+	uint32_t depth = 0;
+	size_t depthEnd = 1;
+	stats.frontier(1);
+
+	for (size_t head = 0; head < bft.size(); ++head) {
+		if (head == depthEnd) {
+			++depth;
+			depthEnd = bft.size();
+			stats.frontier(depthEnd - head);
+		}
+
+		VertexId vertex = bft[head];
+		stats.settle();
+		Visit next = callVisitor(visit, vertex, depth);
+		if (next == Visit::STOP) {
+			stats.stop();
+			return false;
+		}
+		if (next == Visit::SKIP) {
+			continue;
+		}
+
+		stats.scan(edgesEnd(vertex) - edgesBegin(vertex));
+		for (uint32_t e = edgesBegin(vertex); e < edgesEnd(vertex); ++e) {
+			VertexId neighbor = targets[e];
+			if (!visited.isReached(neighbor)) {
+				visited.reach(neighbor);
+				bft.push_back(neighbor);
+			}
+		}
+	}
+	stats.stop();
+	return true;
+}
+
+/** A* search from source to target guided by heuristic */
+template <typename Weight, typename VertexId>
+template <typename Heuristic>
+typename BasicCsrGraph<Weight, VertexId>::Cost
+BasicCsrGraph<Weight, VertexId>::aStarPath(VertexId source, VertexId target,
+	std::vector<VertexId>& path, Heuristic&& heuristic) const
+{
+	Workspace workspace;
+	return aStarPath(source, target, path, heuristic, workspace);
+}
+
+/** A* search keeping its state in workspace
+the heap is keyed by cost plus heuristic, the backward marks hold the
+settled vertices */
+template <typename Weight, typename VertexId>
+template <typename Heuristic>
+typename BasicCsrGraph<Weight, VertexId>::Cost
+BasicCsrGraph<Weight, VertexId>::aStarPath(VertexId source, VertexId target,
+	std::vector<VertexId>& path, Heuristic&& heuristic,
+	Workspace& workspace) const
+{
+	typedef typename Workspace::HeapEntry HeapEntry;
+	path.clear();
+
+	SearchStats& stats = workspace.stats;
+	stats.clear();
+	BasicVertexMarks<Cost, VertexId>& marks = workspace.forward;
+	BasicVertexMarks<Cost, VertexId>& settled = workspace.backward;
+	marks.reset(numVertices);
+	settled.reset(numVertices);
+	std::vector<HeapEntry>& pq = workspace.heap[0];
+	pq.clear();
+	stats.phase(SearchPhase::SEARCH);
+
+	Cost estimate = heuristic(source);
+	if (estimate != UNREACHABLE) {
+		marks.setCost(source, 0, NO_VERTEX);
+		pq.emplace_back(estimate, source);
+		stats.push(pq.size());
+	}
+	while (!pq.empty()) {
+		std::pop_heap(pq.begin(), pq.end(), std::greater<HeapEntry>());
+		VertexId vertex = pq.back().second;
+		pq.pop_back();
+		stats.pop();
+
+		// stale entry, vertex was settled through a cheaper entry
+		if (settled.isReached(vertex)) {
+			stats.stale();
+			continue;
+		}
+		settled.reach(vertex);
+		stats.settle();
+		if (vertex == target) {
+			break;
+		}
+
+		Cost reached = marks.getCost(vertex);
+		stats.scan(edgesEnd(vertex) - edgesBegin(vertex));
+		for (uint32_t e = edgesBegin(vertex); e < edgesEnd(vertex); ++e) {
+			VertexId neighbor = targets[e];
+			Cost challenger = WeightTraits<Weight>::add(reached, weights[e]);
+			if (challenger < marks.getCost(neighbor) &&
+				!settled.isReached(neighbor)) {
+				estimate = heuristic(neighbor);
+				if (estimate == UNREACHABLE) {
+					continue;
+				}
+				marks.setCost(neighbor, challenger, vertex);
+				pq.emplace_back(WeightTraits<Weight>::add(challenger,
+					estimate), neighbor);
+				std::push_heap(pq.begin(), pq.end(),
+					std::greater<HeapEntry>());
+				stats.push(pq.size());
+			}
+		}
+	}
+
+	if (!settled.isReached(target)) {
+		stats.stop();
+		return UNREACHABLE;
+	}
+
+	stats.phase(SearchPhase::OUTPUT);
+	for (VertexId v = target; v != NO_VERTEX; v = marks.getParent(v)) {
+		path.push_back(v);
+	}
+	std::reverse(path.begin(), path.end());
+	stats.stop();
+	return marks.getCost(target);
+}
+
+/** call visit on vertex id, CONTINUE if it returns nothing */
+template <typename Weight, typename VertexId>
+template <typename Visitor>
+Visit BasicCsrGraph<Weight, VertexId>::callVisitor(Visitor& visit,
+	VertexId id, uint32_t depth)
+{
+	if constexpr (std::is_void<decltype(visit(id, depth))>::value) {
+		visit(id, depth);
+		return Visit::CONTINUE;
+	}
+	else {
+		return visit(id, depth);
+	}
+}
+
+/** snapshot of the default Graph */
+typedef BasicCsrGraph<int, uint32_t> CsrGraph;
+
+#endif  // CSRGRAPH_H
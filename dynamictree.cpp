@@ -0,0 +1,154 @@
+/**
+* Shortest-path tree kept up to date while edges are added
+* The repair is Dijkstra with a lazy binary heap: a vertex that gets
+* cheaper again is pushed again and the dearer entry is skipped when
+* it comes off.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "dynamictree.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// This is 80 characters - Keep all lines under 80 characters                 //
+////////////////////////////////////////////////////////////////////////////////
+
+/** constructor, search graph from source */
+template <typename Weight, typename VertexId>
+BasicDynamicTree<Weight, VertexId>::BasicDynamicTree(const Graph& graph,
+	LabelPool::Label source)
+	: graph(graph), source(source)
+{
+	improve(source, 0, LabelPool::NO_LABEL);
+	repair();
+	repaired = 0;
+}
+
+/** return the label of the source */
+template <typename Weight, typename VertexId>
+std::string_view BasicDynamicTree<Weight, VertexId>::getSource() const
+{
+	return graph.labels.view(source);
+}
+
+/** return the lowest cost from the source to the labelled vertex */
+template <typename Weight, typename VertexId>
+typename BasicDynamicTree<Weight, VertexId>::Cost
+BasicDynamicTree<Weight, VertexId>::getCost(
+	std::string_view vertexLabel) const
+{
+	LabelPool::Label vertex = graph.labels.find(vertexLabel);
+	return vertex == LabelPool::NO_LABEL ? UNREACHABLE : costOf(vertex);
+}
+
+/** return the label of the vertex before the labelled vertex */
+template <typename Weight, typename VertexId>
+std::string_view BasicDynamicTree<Weight, VertexId>::getPrevious(
+	std::string_view vertexLabel) const
+{
+	LabelPool::Label vertex = graph.labels.find(vertexLabel);
+	if (vertex == LabelPool::NO_LABEL || vertex >= parent.size() ||
+		parent[vertex] == LabelPool::NO_LABEL) {
+		return std::string_view();
+	}
+	return graph.labels.view(parent[vertex]);
+}
+
+/** fill the maps of djikstraCostToAllVertices */
+template <typename Weight, typename VertexId>
+void BasicDynamicTree<Weight, VertexId>::toMaps(
+	std::map<std::string, Cost>& weight,
+	std::map<std::string, std::string>& previous) const
+{
+	weight.clear();
+	previous.clear();
+	for (LabelPool::Label v = 0; v < parent.size(); ++v) {
+		if (parent[v] != LabelPool::NO_LABEL) {
+			std::string label(graph.labels.view(v));
+			weight.emplace(label, cost[v]);
+			previous.emplace(label, graph.labels.view(parent[v]));
+		}
+	}
+}
+
+/** return number of times a vertex got cheaper since the tree was
+built */
+template <typename Weight, typename VertexId>
+uint64_t BasicDynamicTree<Weight, VertexId>::getRepaired() const
+{
+	return repaired;
+}
+
+/** the edge from - to was added, remember to if it got cheaper */
+template <typename Weight, typename VertexId>
+void BasicDynamicTree<Weight, VertexId>::edgeAdded(LabelPool::Label from,
+	LabelPool::Label to, Weight weight)
+{
+	Cost through = WeightTraits<Weight>::add(costOf(from), weight);
+	if (through < costOf(to)) {
+		improve(to, through, from);
+	}
+}
+
+/** search on from every vertex edgeAdded made cheaper
+a vertex comes off the heap at its final cost, as in Dijkstra, since
+no cost below the cheapest entry can change any more */
+template <typename Weight, typename VertexId>
+void BasicDynamicTree<Weight, VertexId>::repair()
+{
+	while (!heap.empty()) {
+		std::pop_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+		HeapEntry smallest = heap.back();
+		heap.pop_back();
+		LabelPool::Label vertex = smallest.second;
+		if (smallest.first > cost[vertex]) {
+			continue;
+		}
+
+		for (typename BasicVertex<Weight>::Neighbor neighbor :
+			graph.vertices[vertex]->neighbors()) {
+			Cost challenger = WeightTraits<Weight>::add(smallest.first,
+				neighbor.weight);
+			if (challenger < costOf(neighbor.id)) {
+				improve(neighbor.id, challenger, vertex);
+			}
+		}
+	}
+}
+
+/** give vertex the lower cost lower, reached from from */
+template <typename Weight, typename VertexId>
+void BasicDynamicTree<Weight, VertexId>::improve(LabelPool::Label vertex,
+	Cost lower, LabelPool::Label from)
+{
+	if (vertex >= cost.size()) {
+		cost.resize(graph.labels.size(), UNREACHABLE);
+		parent.resize(graph.labels.size(), LabelPool::NO_LABEL);
+	}
+	cost[vertex] = lower;
+	parent[vertex] = from;
+	++repaired;
+	heap.emplace_back(lower, vertex);
+	std::push_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+}
+
+/** return the cost of vertex, UNREACHABLE past the end */
+template <typename Weight, typename VertexId>
+typename BasicDynamicTree<Weight, VertexId>::Cost
+BasicDynamicTree<Weight, VertexId>::costOf(LabelPool::Label vertex) const
+{
+	return vertex < cost.size() ? cost[vertex] : UNREACHABLE;
+}
+
+// the weight and id types listed in graph.cpp
+template class BasicDynamicTree<int, uint32_t>;
+template class BasicDynamicTree<uint16_t, uint16_t>;
+template class BasicDynamicTree<uint32_t, uint32_t>;
+template class BasicDynamicTree<int64_t, uint32_t>;
+template class BasicDynamicTree<float, uint32_t>;
@@ -0,0 +1,111 @@
+/**
+* Shortest-path tree kept up to date while edges are added
+* Graph::trackSource builds the tree of one source once, by Dijkstra
+* over the graph's own adjacency lists, and from then on every edge
+* add or readFile puts in is handed to the tree. An edge u - v only
+* matters if it makes v cheaper. Only then is v given its new cost
+* and the vertices it improves are found by a Dijkstra that starts at
+* v, so only the part of the tree whose costs drop is searched again.
+* This is the insertion half of Ramalingam and Reps' algorithm. Edges
+* are never removed or made dearer, so the other half is not needed.
+* Vertices are numbered by their label handle, which never changes as
+* the graph grows, unlike the ids of a CSR snapshot. The tree belongs
+* to the graph and is read between changes like any const query.
+*/
+
+#ifndef DYNAMICTREE_H
+#define DYNAMICTREE_H
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "graph.h"
+#include "labelpool.h"
+#include "weighttraits.h"
+
+/** Weight and VertexId are those of the graph, see graph.h */
+template <typename Weight, typename VertexId>
+class BasicDynamicTree {
+public:
+	/** graph the tree is kept for */
+	typedef BasicGraph<Weight, VertexId> Graph;
+
+	/** type path costs are added up in */
+	typedef typename WeightTraits<Weight>::Cost Cost;
+
+	/** cost of a vertex that cannot be reached */
+	static constexpr Cost UNREACHABLE = WeightTraits<Weight>::UNREACHABLE;
+
+	/** constructor, search graph from the vertex with label handle
+	source, which must exist */
+	BasicDynamicTree(const Graph& graph, LabelPool::Label source);
+
+	/** return the label of the source */
+	std::string_view getSource() const;
+
+	/** return the lowest cost from the source to the vertex with the
+	given label, UNREACHABLE if it does not exist or cannot be
+	reached */
+	Cost getCost(std::string_view vertexLabel) const;
+
+	/** return the label of the vertex before the vertex with the given
+	label on its cheapest path, empty for the source and for vertices
+	that do not exist or cannot be reached */
+	std::string_view getPrevious(std::string_view vertexLabel) const;
+
+	/** fill the maps Graph::djikstraCostToAllVertices fills, replacing
+	what they held. The costs are the same. When there are several
+	cheapest paths previous may name another one. */
+	void toMaps(std::map<std::string, Cost>& weight,
+		std::map<std::string, std::string>& previous) const;
+
+	/** return number of times a vertex got cheaper since the tree was
+	built, the work the repairs did */
+	uint64_t getRepaired() const;
+
+private:
+	/** only the graph hands edges to the tree */
+	friend class BasicGraph<Weight, VertexId>;
+
+	typedef std::pair<Cost, LabelPool::Label> HeapEntry;
+
+	/** the graph whose vertices and edges are searched */
+	const Graph& graph;
+
+	LabelPool::Label source;
+
+	/** cost and parent by label handle, vertices added after the last
+	repair may be past the end, they cannot be reached yet */
+	std::vector<Cost> cost;
+	std::vector<LabelPool::Label> parent;
+
+	/** vertices that got cheaper and whose edges are not searched yet */
+	std::vector<HeapEntry> heap;
+
+	uint64_t repaired{ 0 };
+
+	/** the edge from - to of the given weight was added, if it makes
+	to cheaper, remember to search on from to */
+	void edgeAdded(LabelPool::Label from, LabelPool::Label to,
+		Weight weight);
+
+	/** search on from every vertex edgeAdded made cheaper */
+	void repair();
+
+	/** give vertex the lower cost lower, reached from from, and
+	remember to search on from it */
+	void improve(LabelPool::Label vertex, Cost lower,
+		LabelPool::Label from);
+
+	/** return the cost of vertex, UNREACHABLE past the end */
+	Cost costOf(LabelPool::Label vertex) const;
+};  // end BasicDynamicTree
+
+/** tree of the default Graph */
+typedef BasicDynamicTree<int, uint32_t> DynamicTree;
+
+#endif  // DYNAMICTREE_H
@@ -0,0 +1,369 @@
+/**
+* Parser for graph edge files
+* The file is memory-mapped and tokenized in place. Every label is
+* copied out once, edges refer to labels by their index.
+*/
+
+#include <algorithm>
+#include <charconv>
+#include <climits>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include "edgefile.h"
+#include "mappedfile.h"
+#include "weighttraits.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// This is 80 characters - Keep all lines under 80 characters                 //
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/** position in the file while parsing */
+struct Cursor {
+	const char* pos;
+	const char* end;
+	size_t line;
+};
+
+/** true for whitespace other than the line break */
+bool isBlank(char c)
+{
+	return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/** skip whitespace up to the end of the line */
+void skipBlanks(Cursor& c)
+{
+	while (c.pos < c.end && isBlank(*c.pos)) {
+		++c.pos;
+	}
+}
+
+/** skip lines that are empty or only whitespace */
+void skipEmptyLines(Cursor& c)
+{
+	skipBlanks(c);
+	while (c.pos < c.end && *c.pos == '\n') {
+		++c.pos;
+		++c.line;
+		skipBlanks(c);
+	}
+}
+
+/** the next word on the current line, empty at the end of the line */
+std::string_view nextToken(Cursor& c)
+{
+	skipBlanks(c);
+	const char* first = c.pos;
+	while (c.pos < c.end && *c.pos != '\n' && !isBlank(*c.pos)) {
+		++c.pos;
+	}
+	return std::string_view(first, c.pos - first);
+}
+
+/** move past the end of the current line
+@return  False if there is anything but whitespace left on it. */
+bool endLine(Cursor& c)
+{
+	skipBlanks(c);
+	if (c.pos == c.end) {
+		return true;
+	}
+	if (*c.pos != '\n') {
+		return false;
+	}
+	++c.pos;
+	++c.line;
+	return true;
+}
+
+/** parse a decimal int with an optional sign
+@return  False if token is not a number or does not fit in an int. */
+bool parseInt(std::string_view token, int& value)
+{
+	size_t i = 0;
+	bool negative = false;
+	if (i < token.size() && (token[i] == '-' || token[i] == '+')) {
+		negative = token[i] == '-';
+		++i;
+	}
+	if (i == token.size()) {
+		return false;
+	}
+
+	long long result = 0;
+	for (; i < token.size(); ++i) {
+		if (token[i] < '0' || token[i] > '9') {
+			return false;
+		}
+		result = result * 10 + (token[i] - '0');
+		if (result > static_cast<long long>(INT_MAX) + 1) {
+			return false;
+		}
+	}
+
+	result = negative ? -result : result;
+	if (result > INT_MAX) {
+		return false;
+	}
+	value = static_cast<int>(result);
+	return true;
+}
+
+/** parse an edge weight, a leading + is allowed
+@return  False, with reason set, if token is not a number of type
+Weight, does not fit in one or is not finite. */
+template <typename Weight>
+bool parseWeight(std::string_view token, Weight& value, std::string& reason)
+{
+	const char* first = token.data();
+	const char* last = token.data() + token.size();
+	if (last - first > 1 && first[0] == '+' && first[1] != '-') {
+		++first;
+	}
+
+	std::from_chars_result result = std::from_chars(first, last, value);
+	if (result.ec == std::errc::result_out_of_range) {
+		reason = "edge weight is out of range";
+		return false;
+	}
+	if (result.ec != std::errc() || result.ptr != last) {
+		reason = std::is_floating_point<Weight>::value ?
+			"edge weight is not a number" : "edge weight is not an integer";
+		return false;
+	}
+	if (!WeightTraits<Weight>::isFinite(value)) {
+		reason = "edge weight is not a finite number";
+		return false;
+	}
+	return true;
+}
+
+/** the edge lines between begin and end, parsed by one thread
+labels are numbered in order of first use within the chunk */
+template <typename Weight>
+struct Chunk {
+	const char* begin;
+	const char* end;
+
+	/** edges, from and to index labels */
+	std::vector<typename BasicEdgeFile<Weight>::Record> records;
+
+	/** distinct labels, pointing into the mapping */
+	std::vector<std::string_view> labels;
+
+	/** line breaks in the chunk, or before the error */
+	size_t lines{ 0 };
+
+	/** why parsing stopped early, empty if it did not */
+	std::string error;
+};
+
+/** parse every edge line of chunk, stopping at the first bad one */
+template <typename Weight>
+void parseChunk(Chunk<Weight>& chunk)
+{
+	Cursor c{ chunk.begin, chunk.end, 0 };
+	std::unordered_map<std::string_view, uint32_t> ids;
+
+	// intern a label, copying nothing
+	auto intern = [&](std::string_view label) {
+		auto found = ids.emplace(label,
+			static_cast<uint32_t>(chunk.labels.size()));
+		if (found.second) {
+			chunk.labels.push_back(label);
+		}
+		return found.first->second;
+	};
+
+	for (;;) {
+		skipEmptyLines(c);
+		if (c.pos == c.end) {
+			break;
+		}
+
+		std::string_view start = nextToken(c);
+		std::string_view end = nextToken(c);
+		std::string_view weight = nextToken(c);
+		typename BasicEdgeFile<Weight>::Record record;
+		if (end.empty()) {
+			chunk.error = "expected \"fromVertex toVertex edgeWeight\"";
+			break;
+		}
+		if (!parseWeight(weight, record.weight, chunk.error)) {
+			break;
+		}
+		if (!endLine(c)) {
+			chunk.error = "unexpected text after the edge weight";
+			break;
+		}
+
+		record.from = intern(start);
+		record.to = intern(end);
+		chunk.records.push_back(record);
+	}
+
+	chunk.lines = c.line;
+}
+
+}  // namespace
+
+/** read and parse filename
+stops at the first malformed line and records why in getError()
+threads is how many threads parse the edge lines, 0 uses every core
+labels and edges come out in the same order as with one thread
+@return  True if the whole file was parsed. */
+template <typename Weight>
+bool BasicEdgeFile<Weight>::load(const std::string& filename, unsigned threads)
+{
+	labels.clear();
+	edges.clear();
+	error.clear();
+
+	MappedFile file;
+	if (!file.open(filename)) {
+		error = filename + ": cannot open file";
+		return false;
+	}
+
+	Cursor c{ file.data(), file.data() + file.size(), 1 };
+	auto fail = [&](size_t line, const std::string& reason) {
+		error = filename + ":" + std::to_string(line) + ": " + reason;
+		labels.clear();
+		edges.clear();
+		return false;
+	};
+
+	int numEdges = 0;
+	skipEmptyLines(c);
+	if (!parseInt(nextToken(c), numEdges) || numEdges < 0) {
+		return fail(c.line, "expected the number of edges");
+	}
+	if (!endLine(c)) {
+		return fail(c.line, "unexpected text after the number of edges");
+	}
+
+	// split the edge lines into chunks of at least MIN_CHUNK bytes
+	// that start at the beginning of a line
+	if (threads == 0) {
+		threads = std::max(1u, std::thread::hardware_concurrency());
+	}
+	size_t bytes = static_cast<size_t>(c.end - c.pos);
+	size_t numChunks = std::max<size_t>(1,
+		std::min<size_t>(threads, bytes / MIN_CHUNK));
+
+	std::vector<Chunk<Weight>> chunks(numChunks);
+	const char* begin = c.pos;
+	for (size_t i = 0; i < numChunks; ++i) {
+		const char* end = c.end;
+		if (i + 1 < numChunks) {
+			end = std::max(begin, c.pos + bytes * (i + 1) / numChunks);
+			end = std::find(end, c.end, '\n');
+			end = end == c.end ? end : end + 1;
+		}
+		chunks[i].begin = begin;
+		chunks[i].end = end;
+		begin = end;
+	}
+
+	std::vector<std::thread> workers;
+	for (size_t i = 1; i < numChunks; ++i) {
+		workers.emplace_back(parseChunk<Weight>, std::ref(chunks[i]));
+	}
+	parseChunk(chunks[0]);
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+
+	// lines after the first numEdges edges are never looked at, so
+	// only an error before that point fails the load
+	size_t line = c.line;
+	size_t needed = static_cast<size_t>(numEdges);
+	size_t found = 0;
+	size_t used = 0;
+	for (; used < numChunks && found < needed; ++used) {
+		const Chunk<Weight>& chunk = chunks[used];
+		if (!chunk.error.empty() && found + chunk.records.size() < needed) {
+			return fail(line + chunk.lines, chunk.error);
+		}
+		found += chunk.records.size();
+		line += chunk.lines;
+	}
+	if (found < needed) {
+		return fail(line, "expected " + std::to_string(numEdges) +
+			" edges, found " + std::to_string(found));
+	}
+
+	// give the labels global indexes in order of first use, which is
+	// the order a single thread would have found them in
+	std::unordered_map<std::string_view, uint32_t> ids;
+	std::vector<std::vector<uint32_t>> remap(used);
+	for (size_t i = 0; i < used; ++i) {
+		const Chunk<Weight>& chunk = chunks[i];
+		size_t numLabels = chunk.labels.size();
+
+		// the last chunk may run past numEdges, its labels are in order
+		// of first use so the ones needed are a prefix
+		if (i + 1 == used && found > needed) {
+			size_t count = chunk.records.size() - (found - needed);
+			numLabels = 0;
+			for (size_t r = 0; r < count; ++r) {
+				numLabels = std::max<size_t>(numLabels, std::max(
+					chunk.records[r].from, chunk.records[r].to) + 1);
+			}
+		}
+
+		remap[i].reserve(numLabels);
+		for (size_t l = 0; l < numLabels; ++l) {
+			auto inserted = ids.emplace(chunk.labels[l],
+				static_cast<uint32_t>(labels.size()));
+			if (inserted.second) {
+				labels.emplace_back(chunk.labels[l]);
+			}
+			remap[i].push_back(inserted.first->second);
+		}
+	}
+
+	// copy the records over in parallel, renumbering their labels
+	edges.resize(needed);
+	auto copyChunk = [&](size_t i, size_t first) {
+		size_t count = std::min(chunks[i].records.size(), needed - first);
+		for (size_t r = 0; r < count; ++r) {
+			Record record = chunks[i].records[r];
+			record.from = remap[i][record.from];
+			record.to = remap[i][record.to];
+			edges[first + r] = record;
+		}
+	};
+	workers.clear();
+	size_t first = 0;
+	for (size_t i = 0; i < used; ++i) {
+		if (i + 1 < used) {
+			workers.emplace_back(copyChunk, i, first);
+		}
+		else {
+			copyChunk(i, first);
+		}
+		first += chunks[i].records.size();
+	}
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+
+	return true;
+}
+
+// the weight types listed in graph.cpp
+template class BasicEdgeFile<int>;
+template class BasicEdgeFile<uint16_t>;
+template class BasicEdgeFile<uint32_t>;
+template class BasicEdgeFile<int64_t>;
+template class BasicEdgeFile<float>;
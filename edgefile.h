@@ -0,0 +1,65 @@
+/**
+* Parser for graph edge files
+* The first line of the file is an integer, indicating number of edges
+* each edge line is in the form of "string string weight"
+* fromVertex  toVertex    edgeWeight
+* Weight is the type of the edge weights, weights that are not numbers
+* of that type or do not fit in it are errors.
+* The file is memory-mapped and tokenized in place. Every label is
+* copied out once, edges refer to labels by their index.
+*/
+
+#ifndef EDGEFILE_H
+#define EDGEFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+template <typename Weight>
+class BasicEdgeFile {
+public:
+	/** one edge line, from and to index getLabels() */
+	struct Record {
+		uint32_t from;
+		uint32_t to;
+		Weight weight;
+	};
+
+	/** smallest piece of a file given to a parsing thread */
+	static constexpr size_t MIN_CHUNK = 1 << 20;
+
+	/** read and parse filename
+	stops at the first malformed line and records why in getError()
+	threads is how many threads parse the edge lines, 0 uses every
+	core. The file is split into line-aligned chunks, each thread
+	interns the labels of its chunk and the results are merged so
+	labels and edges come out in the same order as with one thread
+	@return  True if the whole file was parsed. */
+	bool load(const std::string& filename, unsigned threads = 1);
+
+	/** every distinct label in the file, in order of first use */
+	const std::vector<std::string>& getLabels() const { return labels; }
+
+	/** the edges in file order */
+	const std::vector<Record>& getEdges() const { return edges; }
+
+	/** "filename:line: reason" for the last failed load, else empty */
+	const std::string& getError() const { return error; }
+
+private:
+	/** distinct labels, indexed by Record::from and Record::to */
+	std::vector<std::string> labels;
+
+	/** parsed edge lines */
+	std::vector<Record> edges;
+
+	/** reason the last load failed */
+	std::string error;
+};  // end BasicEdgeFile
+
+/** edge file of the default Graph */
+typedef BasicEdgeFile<int> EdgeFile;
+
+#endif  // EDGEFILE_H
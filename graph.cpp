@@ -6,22 +6,29 @@
 * user can also get the number of vertices, the number of edges, add a vertex
 * to the graph, return the weight of an edge, read from a file, perform depth-
 * first search, breadth-first search, and find Dijkstra's shortest path.
-* Private functions allows user to find and create vertices and visit or
-* unvisit vertices.
+* Private functions allows user to find and create vertices.
+* Queries keep their visited state in a SearchWorkspace, not in the
+* vertices, so they are const and can run at the same time.
+* Any number of threads may call const functions at once. Functions that
+* change the graph, add and readFile, must not run alongside any other
+* call.
 */
 
 #include <queue>
+#include <algorithm>
 #include <climits>
 #include <set>
 #include <iostream>
-#include <fstream>
 #include <map>
-#include <stack>
 #include <queue>
 #include <vector>
 
+#include "dynamictree.h"
+#include "edgefile.h"
 #include "graph.h"
 
+using namespace std;
+
 /**
 * A graph is made up of vertices and edges
 * A vertex can be connected to other vertices via weighted, directed edge
@@ -34,7 +41,18 @@
 
 
 /** constructor, empty graph */
-Graph::Graph() 
+template <typename Weight, typename VertexId>
+BasicGraph<Weight, VertexId>::BasicGraph() : BasicGraph(HEAP)
+{
+}
+
+/** constructor, empty graph using the given allocation */
+template <typename Weight, typename VertexId>
+BasicGraph<Weight, VertexId>::BasicGraph(Allocation allocation)
+	: arena(allocation == ARENA ?
+		new std::pmr::monotonic_buffer_resource(ARENA_SLAB) : nullptr),
+	memory(arena ? arena.get() : std::pmr::new_delete_resource()),
+	labels(memory), vertices(memory)
 {
 	numberOfEdges = 0;
 	numberOfVertices = 0;
@@ -43,217 +61,281 @@ Graph::Graph()
 /** destructor, delete all vertices and edges
 only vertices stored in map
 no pointers to edges created by graph */
-Graph::~Graph()
+template <typename Weight, typename VertexId>
+BasicGraph<Weight, VertexId>::~BasicGraph()
 {
-	map<string, Vertex*>::iterator it;
+	// everything a vertex owns came from the arena, which frees it
+	// all at once, so the vertices are not destroyed one by one
+	if (arena) {
+		return;
+	}
 
-	for (it = vertices.begin(); it != vertices.end(); ++it) {
-			delete it->second;
+	std::pmr::polymorphic_allocator<BasicVertex<Weight>> allocator(memory);
+	for (BasicVertex<Weight>* vertex : vertices) {
+		vertex->~BasicVertex();
+		allocator.deallocate(vertex, 1);
 	}
 
 }
 
 /** return number of vertices */
-int Graph::getNumVertices() const
+template <typename Weight, typename VertexId>
+int BasicGraph<Weight, VertexId>::getNumVertices() const
 {
 	
 	return numberOfVertices; 
 }
 
 /** return number of vertices */
-int Graph::getNumEdges() const
+template <typename Weight, typename VertexId>
+int BasicGraph<Weight, VertexId>::getNumEdges() const
 { 
 	return numberOfEdges;
 }
 
+/** return how the edge weights are spread */
+template <typename Weight, typename VertexId>
+const WeightProfile<Weight>&
+BasicGraph<Weight, VertexId>::getWeightProfile() const
+{
+	return weightProfile;
+}
+
 /** add a new edge between start and end vertex
 if the vertices do not exist, create them
 calls Vertex::connect
 a vertex cannot connect to itself
-or have multiple edges to another vertex */
-bool Graph::add(std::string start, std::string end, int edgeWeight) {
+or have multiple edges to another vertex
+returns false if a new vertex would be more than MAX_VERTICES,
+the graph already has MAX_EDGES edges or the weight is NaN or
+infinite */
+template <typename Weight, typename VertexId>
+bool BasicGraph<Weight, VertexId>::add(std::string_view start,
+	std::string_view end, Weight edgeWeight) {
+
+	if (static_cast<uint64_t>(numberOfEdges) >= MAX_EDGES ||
+		!WeightTraits<Weight>::isFinite(edgeWeight)) {
+		return false;
+	}
 
-	Vertex * added;
-		if (findVertex(start)) {
-			added = findVertex(start);
-		}
-	
-		else {
-			added = findOrCreateVertex(start);
-			vertices.insert({ start, added });
-		}
+	// check the new vertices fit before adding either of them
+	size_t newVertices = (labels.find(start) == LabelPool::NO_LABEL) +
+		(end != start && labels.find(end) == LabelPool::NO_LABEL);
+	if (vertices.size() + newVertices > MAX_VERTICES) {
+		return false;
+	}
 
-		Vertex * endVertex;
-		if (!findVertex(end)) {
-			endVertex = findOrCreateVertex(end);
-			vertices.insert({ end, endVertex });
-		}
+	BasicVertex<Weight> * added = findOrCreateVertex(start);
+	BasicVertex<Weight> * endVertex = findOrCreateVertex(end);
 
+	snapshot.reset();
+	treeCache.clear();
+	int neighbors = added->getNumberOfNeighbors();
+	bool connected = added->connect(endVertex->getLabelId(), edgeWeight);
+	if (added->getNumberOfNeighbors() > neighbors) {
 		numberOfEdges++;
-		return added->connect(end, edgeWeight);
+		weightProfile.add(edgeWeight);
+		for (auto& tracked : trackedTrees) {
+			tracked.second->edgeAdded(added->getLabelId(),
+				endVertex->getLabelId(), edgeWeight);
+			tracked.second->repair();
+		}
+	}
+	return connected;
 }
 
 /** return weight of the edge between start and end
-returns INT_MAX if not connected or vertices don't exist */
-int Graph::getEdgeWeight(std::string start, std::string end)
+returns NO_EDGE if not connected or vertices don't exist */
+template <typename Weight, typename VertexId>
+Weight BasicGraph<Weight, VertexId>::getEdgeWeight(std::string_view start,
+	std::string_view end) const
 { 
-	map<string, Vertex*>::iterator it;
+	BasicVertex<Weight> * weight = findVertex(start);
 
-	for (it = vertices.begin(); it != vertices.end(); ++it) {
-		if (it->first == start) {
-			Vertex * weight = it->second;
-			return weight->getEdgeWeight(end);
-		}
+	if (weight) {
+		return weight->getEdgeWeight(end);
 	}
 
-		return INT_MAX;
+	return NO_EDGE;
 }
 
 /** read edges from file
 the first line of the file is an integer, indicating number of edges
-each edge line is in the form of "string string int"
-fromVertex  toVertex    edgeWeight */
-void Graph::readFile(std::string filename)
+each edge line is in the form of "string string weight"
+fromVertex  toVertex    edgeWeight
+a malformed line is reported on cerr and nothing is added
+threads is how many threads parse large files, 0 uses every core */
+template <typename Weight, typename VertexId>
+bool BasicGraph<Weight, VertexId>::readFile(std::string filename,
+	unsigned threads)
 {
-	ifstream fin;
-	int count = 0;
-	fin.open(filename);
-	int numEdges;
-	string start;
-	string end;
-	int weight;
-
-	fin >> numEdges;
-
-	while (count < numEdges) {
-		fin >> start;
-		fin >> end;
-		fin >> weight;
+	BasicEdgeFile<Weight> file;
+	if (!file.load(filename, threads)) {
+		cerr << file.getError() << endl;
+		return false;
+	}
 
-		add(start, end, weight);
-		count++;
+	if (!addEdges(file.getLabels(), file.getEdges())) {
+		cerr << filename << ": more than " << MAX_VERTICES
+			<< " vertices or " << MAX_EDGES << " edges" << endl;
+		return false;
 	}
-	
+	return true;
 }
 
-/** depth-first traversal starting from startLabel
-call the function visit on each vertex label */
-void Graph::depthFirstTraversal(std::string startLabel,
- void visit(const std::string&))
+/** add a batch of edges between the vertices labelled in edgeLabels
+the edges are sorted by the alphabetical place of the start label, then
+of the end label and then by position, so the first of a repeated edge
+stays first and each run of edges out of one vertex goes into its
+adjacency list in order. At 2^16 vertices this loads about 3.3M
+edges/s on R-MAT and 1.4M/s on a grid, not tens of millions: about
+half the time is the sorts, most of the rest is the map node every
+edge of an adjacency list is. A contiguous sorted block per vertex
+would be needed to go faster. */
+template <typename Weight, typename VertexId>
+bool BasicGraph<Weight, VertexId>::addEdges(
+	const vector<string>& edgeLabels, const vector<EdgeRecord>& edges)
 {
-	stack<string> dft;
-	Vertex * temp;
-	Vertex * check;
-	int loopCount = 0;
-	string neighbor;
-
-	// empty map
-	if (this->vertices.empty()) {
-		return;
+	for (const EdgeRecord& edge : edges) {
+		if (edge.from >= edgeLabels.size() || edge.to >= edgeLabels.size() ||
+			!WeightTraits<Weight>::isFinite(edge.weight)) {
+			return false;
+		}
 	}
 
-	this->unvisitVertices();
-	dft.push(startLabel);
-
-	findVertex(startLabel)->visit();
-	visit(startLabel);
-
-	// if starter vertex has no neighbors
-	if (findVertex(startLabel)->getNumberOfNeighbors() == 0) {
-		return;
+	// the alphabetical place of every label, the same for equal labels
+	vector<uint32_t> byText(edgeLabels.size());
+	for (uint32_t i = 0; i < byText.size(); ++i) {
+		byText[i] = i;
+	}
+	sort(byText.begin(), byText.end(), [&edgeLabels](uint32_t a, uint32_t b) {
+		return edgeLabels[a] < edgeLabels[b];
+	});
+	vector<uint32_t> place(edgeLabels.size());
+	for (size_t i = 0; i < byText.size(); ++i) {
+		place[byText[i]] = i > 0 &&
+			edgeLabels[byText[i]] == edgeLabels[byText[i - 1]] ?
+			place[byText[i - 1]] : static_cast<uint32_t>(i);
 	}
 
-	while (!dft.empty()) {
-
-		temp = findVertex(dft.top());
-		temp->resetNeighbor();
+	// look every label up once, a label listed twice is one vertex
+	vector<LabelPool::Label> handles(edgeLabels.size());
+	size_t newVertices = 0;
+	for (size_t i = 0; i < edgeLabels.size(); ++i) {
+		handles[i] = labels.find(edgeLabels[i]);
+		newVertices += handles[i] == LabelPool::NO_LABEL &&
+			byText[place[i]] == i;
+	}
 
-		// loops until it finds an unvisited neighbor
-		while (loopCount < temp->getNumberOfNeighbors()) {
-			neighbor = temp->getCurrentNeighbor();
-			check = findVertex(neighbor);
-			
-			if (check->isVisited()) {
-				neighbor = temp->getNextNeighbor();
-				check = findVertex(neighbor);
-				loopCount++;
+	struct Pending {
+		uint32_t fromPlace;
+		uint32_t toPlace;
+		uint32_t position;
+	};
+	vector<Pending> pending(edges.size());
+	for (size_t e = 0; e < edges.size(); ++e) {
+		pending[e] = Pending{ place[edges[e].from], place[edges[e].to],
+			static_cast<uint32_t>(e) };
+	}
+	sort(pending.begin(), pending.end(),
+		[](const Pending& a, const Pending& b) {
+			if (a.fromPlace != b.fromPlace) {
+				return a.fromPlace < b.fromPlace;
 			}
-			else {
-				break;
+			if (a.toPlace != b.toPlace) {
+				return a.toPlace < b.toPlace;
 			}
+			return a.position < b.position;
+		});
+
+	// an edge repeated in the batch is one edge, check the vertices and
+	// edges fit before adding any of them
+	size_t distinct = 0;
+	for (size_t i = 0; i < pending.size(); ++i) {
+		distinct += i == 0 ||
+			pending[i].fromPlace != pending[i - 1].fromPlace ||
+			pending[i].toPlace != pending[i - 1].toPlace;
+	}
+	if (vertices.size() + newVertices > MAX_VERTICES ||
+		numberOfEdges + distinct > MAX_EDGES) {
+		return false;
+	}
+	for (size_t i = 0; i < edgeLabels.size(); ++i) {
+		if (handles[i] == LabelPool::NO_LABEL) {
+			handles[i] = findOrCreateVertex(edgeLabels[i])->getLabelId();
 		}
+	}
 
-		temp = findVertex(neighbor);
-		loopCount = 0;
-
-		// pushes onto stack
-		if (temp->isVisited() == false) {
-			dft.push(neighbor);
-			temp->visit();
-			visit(neighbor);
+	vector<typename BasicVertex<Weight>::Connection> run;
+	for (size_t begin = 0; begin < pending.size();) {
+		LabelPool::Label from = handles[edges[pending[begin].position].from];
+		run.clear();
+		size_t end = begin;
+		for (; end < pending.size() &&
+			pending[end].fromPlace == pending[begin].fromPlace; ++end) {
+			if (end == begin ||
+				pending[end].toPlace != pending[end - 1].toPlace) {
+				const EdgeRecord& edge = edges[pending[end].position];
+				run.emplace_back(handles[edge.to], edge.weight);
+			}
 		}
-		else {
-			dft.pop();
+		begin = end;
+
+		size_t added = vertices[from]->connectSorted(run.begin(), run.end());
+		numberOfEdges += static_cast<int>(added);
+		for (size_t i = 0; i < added; ++i) {
+			weightProfile.add(run[i].second);
+			for (auto& tracked : trackedTrees) {
+				tracked.second->edgeAdded(from, run[i].first, run[i].second);
+			}
 		}
 	}
 
+	// one search per tree for the whole batch
+	for (auto& tracked : trackedTrees) {
+		tracked.second->repair();
+	}
+	snapshot.reset();
+	treeCache.clear();
+	return true;
 }
 
-/** breadth-first traversal starting from startLabel
+/** depth-first traversal starting from startLabel
 call the function visit on each vertex label */
-void Graph::breadthFirstTraversal(std::string startLabel,
- void visit(const std::string&))
+template <typename Weight, typename VertexId>
+void BasicGraph<Weight, VertexId>::depthFirstTraversal(
+ std::string_view startLabel,
+ void visit(const std::string&)) const
 {
-	int loopCount = 0;
-	string neighbor;
-	Vertex * check;
-	queue<string>bft;
-	Vertex * temp;
-	this->unvisitVertices();
-
-	// empty map
-	if (this->vertices.empty()) {
-		return;
-	}
-
-	bft.push(startLabel);
-
-	findVertex(startLabel)->visit();
-
-	// if starter vertex has no neighbors
-	if (findVertex(startLabel)->getNumberOfNeighbors() == 0) {
-		visit(bft.front());
-		return;
-	}
-
-	while (!bft.empty()) {
-
-		temp = findVertex(bft.front());
-		temp->resetNeighbor();
-
-		// loops until it finds an unvisited neighbor
-		while (loopCount < temp->getNumberOfNeighbors()) {
-			neighbor = temp->getCurrentNeighbor();
-			check = findVertex(neighbor);
+	getSnapshot().depthFirstTraversal(startLabel, visit);
+}
 
-			if (check->isVisited()) {
-				neighbor = temp->getNextNeighbor();
-				check = findVertex(neighbor);
-				loopCount++;
-			}
-			else {
-				bft.push(neighbor);
-				findVertex(neighbor)->visit();
-			}
-		}
+/** depth-first traversal keeping its visited state in workspace */
+template <typename Weight, typename VertexId>
+void BasicGraph<Weight, VertexId>::depthFirstTraversal(
+ std::string_view startLabel,
+ void visit(const std::string&), Workspace& workspace) const
+{
+	getSnapshot().depthFirstTraversal(startLabel, visit, workspace);
+}
 
-		//calls visit on the top value in the queue and then pops it
-		temp = findVertex(neighbor);
-		loopCount = 0;
-		visit(bft.front());
-		bft.pop();
+/** breadth-first traversal starting from startLabel
+call the function visit on each vertex label */
+template <typename Weight, typename VertexId>
+void BasicGraph<Weight, VertexId>::breadthFirstTraversal(
+ std::string_view startLabel,
+ void visit(const std::string&)) const
+{
+	getSnapshot().breadthFirstTraversal(startLabel, visit);
+}
 
-	}
+/** breadth-first traversal keeping its visited state in workspace */
+template <typename Weight, typename VertexId>
+void BasicGraph<Weight, VertexId>::breadthFirstTraversal(
+ std::string_view startLabel,
+ void visit(const std::string&), Workspace& workspace) const
+{
+	getSnapshot().breadthFirstTraversal(startLabel, visit, workspace);
 }
 
 /** find the lowest cost from startLabel to all vertices that can be reached
@@ -262,195 +344,234 @@ record costs in the given map weight
 weight["F"] = 10 indicates the cost to get to "F" is 10
 record the shortest path to each vertex using given map previous
 previous["F"] = "C" indicates get to "F" via "C"
+runs on the CSR snapshot in O((V + E) log V)
 
 cpplint gives warning to use pointer instead of a non-const map 
 which I am ignoring for readability */
-void Graph::djikstraCostToAllVertices(std::string startLabel,
- std::map<std::string, int>& weight, std::map<std::string,
- std::string>& previous)
-{	
-	weight.clear();
-	previous.clear();
-	this->unvisitVertices();
-	
-	// holds possible neighbors that have not been used yet
-	priority_queue<pair<string, int>, vector<pair<string, int>>,
-	 myComparison>pq;
-	
-	// list of vertices visited
-	vector<string>vertexSet;
-	
-	int i = 0;
-	string next;
-	Vertex * find = findVertex(startLabel);
-	find->visit();
-	int size = 0;
-
-	vertexSet.push_back(startLabel);
-	size++;
-
-	// loops until every vertex has been visited
-	while (size < this->getNumVertices()) {
-		
-		Vertex * temp = findVertex(vertexSet[vertexSet.size() - 1]);
-		temp->resetNeighbor();
-		string start = temp->getLabel();
-
-		// loops until all neighbors have been visited
-		while (i < temp->getNumberOfNeighbors()) {
-			
-			// special case to get first neighbor
-			if (i == 0) {
-				next = temp->getCurrentNeighbor();
-				find = findVertex(next);
-			}
-
-			else {
-				next = temp->getNextNeighbor();
-				find = findVertex(next);
-			}
+template <typename Weight, typename VertexId>
+void BasicGraph<Weight, VertexId>::djikstraCostToAllVertices(
+ std::string_view startLabel, std::map<std::string, Cost>& weight,
+ std::map<std::string, std::string>& previous) const
+{
+	Workspace workspace;
+	djikstraCostToAllVertices(startLabel, weight, previous, workspace);
+}
 
-			// special case: protects against the starter vertex
-			// being added to any of the maps
-			if (next != startLabel) {
-				getWeight(find, start, pq, weight, previous);
-				getPrevious(find, start, previous);
-			}
-			i++;
-		}
+/** djikstraCostToAllVertices keeping its state in workspace */
+template <typename Weight, typename VertexId>
+void BasicGraph<Weight, VertexId>::djikstraCostToAllVertices(
+	std::string_view startLabel, std::map<std::string, Cost>& weight,
+	std::map<std::string, std::string>& previous,
+	Workspace& workspace) const
+{
+	if (treeCache.getBudget() == 0) {
+		getSnapshot().djikstraCostToAllVertices(startLabel, weight,
+			previous, workspace);
+		return;
+	}
 
-		// if the queue is empty, all possible vertices have been
-		// reached
-		if (pq.empty()) {
-			return;
-		}
-		pair<string, int> smallest = pq.top();
-		pq.pop();
-		vertexSet.push_back(get<0>(smallest));
-		size++;
-		i = 0;
+	std::shared_ptr<const ShortestPathTree> tree =
+		shortestPathTree(startLabel, workspace);
+	workspace.stats.phase(SearchPhase::OUTPUT);
+	if (tree) {
+		tree->toMaps(weight, previous);
+	}
+	else {
+		weight.clear();
+		previous.clear();
 	}
+	workspace.stats.stop();
 }
 
-/** Helper function for Dijkstra. Fills the weight map.
- Checks if the map already has that value in it */
-void Graph::getWeight(Vertex * find, string startLabel,
- priority_queue<pair<string, int>, vector<pair<string, int>>, myComparison>&pq,
- std::map<std::string, int>& weight, std::map<std::string,
- std::string>& previous)
+/** return the shortest-path tree from startLabel */
+template <typename Weight, typename VertexId>
+std::shared_ptr<const typename BasicGraph<Weight, VertexId>::ShortestPathTree>
+BasicGraph<Weight, VertexId>::shortestPathTree(
+	std::string_view startLabel) const
 {
-	
-	string destination;
-	string start = startLabel;
+	Workspace workspace;
+	return shortestPathTree(startLabel, workspace);
+}
 
-	destination = find->getLabel();
-	int cost = this->getEdgeWeight(start, destination);
-	cost += calculateWeight(weight, start);
-	findVertex(destination)->visit();
+/** shortestPathTree keeping its state in workspace
+a tree from the cache needs no search, so the counters are cleared */
+template <typename Weight, typename VertexId>
+std::shared_ptr<const typename BasicGraph<Weight, VertexId>::ShortestPathTree>
+BasicGraph<Weight, VertexId>::shortestPathTree(std::string_view startLabel,
+	Workspace& workspace) const
+{
+	const Snapshot& csr = getSnapshot();
+	VertexId source = csr.findVertex(startLabel);
+	std::shared_ptr<const ShortestPathTree> tree;
+	if (source != Snapshot::NO_VERTEX) {
+		tree = treeCache.find(source);
+	}
+	if (source == Snapshot::NO_VERTEX || tree) {
+		workspace.stats.clear();
+		workspace.stats.stop();
+		return tree;
+	}
 
-	findDuplicates(weight, destination, cost, previous);
-	pq.push(make_pair(destination, cost));
+	tree = std::make_shared<const ShortestPathTree>(csr, source, workspace);
+	treeCache.insert(tree);
+	return tree;
+}
 
-	weight.insert({ destination, cost });
+/** keep up to budget bytes of shortest-path trees */
+template <typename Weight, typename VertexId>
+void BasicGraph<Weight, VertexId>::setTreeCacheBudget(size_t budget)
+{
+	treeCache.setBudget(budget);
 }
 
+/** return the tree cache */
+template <typename Weight, typename VertexId>
+const typename BasicGraph<Weight, VertexId>::TreeCache&
+BasicGraph<Weight, VertexId>::getTreeCache() const
+{
+	return treeCache;
+}
 
-/** helper fuction for Dijkstra, fills the previous map */
-void Graph::getPrevious(Vertex * find, string startLabel, std::map<std::string,
- std::string>& previous)
+/** djikstraCostToAllVertices by parallel delta-stepping */
+template <typename Weight, typename VertexId>
+void BasicGraph<Weight, VertexId>::deltaSteppingCostToAllVertices(
+	std::string_view startLabel, std::map<std::string, Cost>& weight,
+	std::map<std::string, std::string>& previous, Cost delta,
+	unsigned threads) const
 {
-	string start = startLabel;
-	string destination;
+	getSnapshot().deltaSteppingCostToAllVertices(startLabel, weight,
+		previous, delta, threads);
+}
 
-	destination = find->getLabel();
-	previous.insert({ destination, start });
-	findVertex(destination)->visit();
+/** return the lowest cost from start to target
+returns UNREACHABLE if target cannot be reached
+path is filled with the labels from start to target */
+template <typename Weight, typename VertexId>
+typename BasicGraph<Weight, VertexId>::Cost
+BasicGraph<Weight, VertexId>::shortestPath(
+	std::string_view start, std::string_view target,
+	std::vector<std::string>& path) const
+{
+	Workspace workspace;
+	return shortestPath(start, target, path, workspace);
 }
 
-/** helper function for getWeight, if a vertex is multiple vertices away from
-     the starter node it adds up the total weights */
-int Graph::calculateWeight(std::map<std::string, int>& weight, string start)
+/** shortestPath keeping its state in workspace */
+template <typename Weight, typename VertexId>
+typename BasicGraph<Weight, VertexId>::Cost
+BasicGraph<Weight, VertexId>::shortestPath(
+	std::string_view start, std::string_view target,
+	std::vector<std::string>& path, Workspace& workspace) const
 {
-	int newWeight = 0;
-	string check;
-	map<string, int>::iterator it;
-
-		for (it = weight.begin(); it != weight.end(); ++it) {
-			if (it->first == start) {
-				newWeight += it->second;
-				check = it->first;
-			}
-		}
+	path.clear();
+	const Snapshot& csr = getSnapshot();
+	VertexId from = csr.findVertex(start);
+	VertexId to = csr.findVertex(target);
+	if (from == Snapshot::NO_VERTEX || to == Snapshot::NO_VERTEX) {
+		return UNREACHABLE;
+	}
 
+	std::vector<VertexId> ids;
+	Cost cost = csr.shortestPath(from, to, ids, workspace);
+	for (VertexId id : ids) {
+		path.emplace_back(csr.getLabel(id));
+	}
+	return cost;
+}
 
-	return newWeight;
+/** same result as shortestPath, searches from both ends at once */
+template <typename Weight, typename VertexId>
+typename BasicGraph<Weight, VertexId>::Cost
+BasicGraph<Weight, VertexId>::bidirectionalShortestPath(
+	std::string_view start, std::string_view target,
+	std::vector<std::string>& path) const
+{
+	Workspace workspace;
+	return bidirectionalShortestPath(start, target, path, workspace);
 }
 
-/* Helper function for getWeight. Removes a specific value from the map */
-void Graph::removeWeight(std::map<std::string, int>& weight, string remove)
+/** bidirectionalShortestPath keeping its state in workspace */
+template <typename Weight, typename VertexId>
+typename BasicGraph<Weight, VertexId>::Cost
+BasicGraph<Weight, VertexId>::bidirectionalShortestPath(
+	std::string_view start, std::string_view target,
+	std::vector<std::string>& path, Workspace& workspace) const
 {
-	map<string, int>::iterator it;
+	path.clear();
+	const Snapshot& csr = getSnapshot();
+	VertexId from = csr.findVertex(start);
+	VertexId to = csr.findVertex(target);
+	if (from == Snapshot::NO_VERTEX || to == Snapshot::NO_VERTEX) {
+		return UNREACHABLE;
+	}
 
-	for (it = weight.begin(); it != weight.end(); ++it) {
-		if (it->first == remove) {
-			weight.erase(it);
-			return;
-		}
+	std::vector<VertexId> ids;
+	Cost cost = csr.bidirectionalShortestPath(from, to, ids, workspace);
+	for (VertexId id : ids) {
+		path.emplace_back(csr.getLabel(id));
 	}
+	return cost;
 }
 
-/* Helper function for getPrevious. Removes a specific value from the map */
-void Graph::removePrevious(std::map<std::string, string>& previous,
- string remove)
+/** keep the shortest-path tree from startLabel up to date */
+template <typename Weight, typename VertexId>
+const typename BasicGraph<Weight, VertexId>::DynamicTree*
+BasicGraph<Weight, VertexId>::trackSource(std::string_view startLabel)
 {
-	map<string, string>::iterator it;
+	LabelPool::Label source = labels.find(startLabel);
+	if (source == LabelPool::NO_LABEL) {
+		return nullptr;
+	}
 
-	for (it = previous.begin(); it != previous.end(); ++it) {
-		if (it->first == remove) {
-			previous.erase(it);
-			return;
-		}
+	std::unique_ptr<DynamicTree>& tree = trackedTrees[source];
+	if (!tree) {
+		tree.reset(new DynamicTree(*this, source));
 	}
+	return tree.get();
 }
 
-/* Checks if a value is already in the weight map. If it is, it removes it
-   and also removes that value from the previous map */
-void Graph::findDuplicates(std::map<std::string, int>& weight, string find,
- int challenger, std::map<std::string, string>& previous)
+/** stop keeping the tree of startLabel */
+template <typename Weight, typename VertexId>
+bool BasicGraph<Weight, VertexId>::untrackSource(std::string_view startLabel)
 {
-	map<string, int>::iterator it;
-
-	for (it = weight.begin(); it != weight.end(); ++it) {
-		if (it->first == find) {
-			if (it->second > challenger) {
-				string remove = it->first;
-				removeWeight(weight, remove);
-				removePrevious(previous, remove);
-				return;
-			}
-		}
-	}
+	return trackedTrees.erase(labels.find(startLabel)) > 0;
 }
 
+/** write the graph to filename as a binary CSR snapshot */
+template <typename Weight, typename VertexId>
+bool BasicGraph<Weight, VertexId>::saveBinary(const std::string& filename) const
+{
+	return getSnapshot().saveBinary(filename);
+}
 
-/** mark all verticies as unvisited */
-void Graph::unvisitVertices()
+/** return an immutable CSR snapshot of the graph */
+template <typename Weight, typename VertexId>
+typename BasicGraph<Weight, VertexId>::Snapshot
+BasicGraph<Weight, VertexId>::freeze() const
 {
-	map<string, Vertex*>::iterator it;
+	return Snapshot(*this);
+}
 
-	for (it = vertices.begin(); it != vertices.end(); ++it) {
-		it->second->unvisit();
+/** return the snapshot, building it if the graph has changed */
+template <typename Weight, typename VertexId>
+const typename BasicGraph<Weight, VertexId>::Snapshot&
+BasicGraph<Weight, VertexId>::getSnapshot() const
+{
+	std::lock_guard<std::mutex> guard(snapshotLock);
+	if (!snapshot) {
+		snapshot.reset(new Snapshot(*this));
 	}
+	return *snapshot;
 }
 
 /** find a vertex, if it does not exist return nullptr */
-Vertex* Graph::findVertex(const std::string& vertexLabel) {
-	 
-	map<string, Vertex*>::iterator it;
+template <typename Weight, typename VertexId>
+BasicVertex<Weight>* BasicGraph<Weight, VertexId>::findVertex(
+	std::string_view vertexLabel) const {
 
-	it = vertices.find(vertexLabel);
-	if (it != vertices.end()) {
-		return it->second;
+	LabelPool::Label label = labels.find(vertexLabel);
+	if (label != LabelPool::NO_LABEL) {
+		return vertices[label];
 	}
 
 	else {
@@ -458,22 +579,37 @@ Vertex* Graph::findVertex(const std::string& vertexLabel) {
 	}
 }
 
-/** find a vertex, if it does not exist create it and return it */
-Vertex* Graph::findOrCreateVertex(const std::string& vertexLabel) {
-	
-	map<string, Vertex*>::iterator it;
+/** find a vertex, if it does not exist create it and return it
+returns nullptr if the graph already has MAX_VERTICES vertices */
+template <typename Weight, typename VertexId>
+BasicVertex<Weight>* BasicGraph<Weight, VertexId>::findOrCreateVertex(
+	std::string_view vertexLabel) {
 
-	it = vertices.find(vertexLabel);
-	if (it != vertices.end()) {
-		return it->second;
+	LabelPool::Label label = labels.find(vertexLabel);
+	if (label != LabelPool::NO_LABEL) {
+		return vertices[label];
+	}
+
+	else if (vertices.size() >= MAX_VERTICES) {
+		return NULL;
 	}
 
 	else {
-		Vertex * temp = new Vertex(vertexLabel);
+		label = labels.intern(vertexLabel);
+		std::pmr::polymorphic_allocator<BasicVertex<Weight>>
+			allocator(memory);
+		BasicVertex<Weight> * temp = allocator.allocate(1);
+		new (temp) BasicVertex<Weight>(label, labels, memory);
+		vertices.push_back(temp);
 		numberOfVertices++;
 		return temp;
 	}
 }
 
-
-
+// every weight and id type a graph can be built with, the other
+// templates are instantiated for the same types
+template class BasicGraph<int, uint32_t>;
+template class BasicGraph<uint16_t, uint16_t>;
+template class BasicGraph<uint32_t, uint32_t>;
+template class BasicGraph<int64_t, uint32_t>;
+template class BasicGraph<float, uint32_t>;
@@ -6,28 +6,105 @@
 * user can also get the number of vertices, the number of edges, add a vertex
 * to the graph, return the weight of an edge, read from a file, perform depth-
 * first search, breadth-first search, and find Dijkstra's shortest path.
-* Private functions allows user to find and create vertices and visit or
-* unvisit vertices.
+* Private functions allows user to find and create vertices.
+* Queries keep their visited state in a SearchWorkspace, not in the
+* vertices, so they are const and can run at the same time.
+* Any number of threads may call const functions at once. Functions that
+* change the graph, add and readFile, must not run alongside any other
+* call.
+* Shortest-path trees can be kept in a cache by source, see treecache.h.
+* It is off until setTreeCacheBudget gives it room and is cleared by
+* every change to the graph. The trees of sources passed to trackSource
+* are repaired instead as edges are added, see dynamictree.h.
+* Weight is the type of the edge weights and VertexId the type of the
+* ids in the CSR snapshot, see weighttraits.h and csrgraph.h. Graph uses
+* int weights and uint32_t ids.
 */
 
 #ifndef GRAPH_H
 #define GRAPH_H
+#include <algorithm>
+#include <cstdint>
 #include <map>
 #include <string>
+#include <string_view>
+#include <vector>
 
+#include "edgefile.h"
+#include "labelpool.h"
 #include "vertex.h"
-#include "edge.h"
-#include <queue>
+#include "csrgraph.h"
+#include "searchworkspace.h"
+#include "treecache.h"
+#include "weightprofile.h"
+#include "weighttraits.h"
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
 
-class Graph {
+template <typename Weight, typename VertexId>
+class BasicDynamicTree;
+
+template <typename Weight, typename VertexId>
+class BasicGraph {
 public:
+	/** type path costs are added up in */
+	typedef typename WeightTraits<Weight>::Cost Cost;
+
+	/** snapshot the queries run on */
+	typedef BasicCsrGraph<Weight, VertexId> Snapshot;
+
+	/** per-query state for searches on this graph */
+	typedef BasicSearchWorkspace<Cost, VertexId> Workspace;
+
+	/** costs and parents of one search from a source, see treecache.h */
+	typedef BasicShortestPathTree<Weight, VertexId> ShortestPathTree;
+
+	/** cache of shortest-path trees, see treecache.h */
+	typedef BasicTreeCache<Weight, VertexId> TreeCache;
+
+	/** shortest-path tree repaired as edges are added, see
+	dynamictree.h */
+	typedef BasicDynamicTree<Weight, VertexId> DynamicTree;
+
+	/** edge for addEdges, from and to index a list of labels */
+	typedef typename BasicEdgeFile<Weight>::Record EdgeRecord;
+
+	/** cost of a vertex that cannot be reached */
+	static constexpr Cost UNREACHABLE = WeightTraits<Weight>::UNREACHABLE;
+
+	/** returned by getEdgeWeight for an edge that does not exist */
+	static constexpr Weight NO_EDGE = WeightTraits<Weight>::NO_EDGE;
+
+	/** most vertices a graph can have, the largest VertexId marks
+	a missing vertex */
+	static constexpr size_t MAX_VERTICES =
+		std::numeric_limits<VertexId>::max();
+
+	/** most edges a graph can have, the edge count is an int and a
+	snapshot of the graph must fit its uint32_t offsets */
+	static constexpr uint64_t MAX_EDGES = std::min<uint64_t>(
+		std::numeric_limits<int>::max(),
+		Snapshot::MAX_EDGES);
+
+	/** where vertices, adjacency lists and labels are allocated
+	HEAP allocates and frees each one on its own
+	ARENA carves them out of large slabs that are all released at once
+	when the graph is destroyed, memory of removed edges is only
+	reclaimed then */
+	enum Allocation { HEAP, ARENA };
+
 	/** constructor, empty graph */
-	Graph();
+	BasicGraph();
+
+	/** constructor, empty graph using the given allocation */
+	explicit BasicGraph(Allocation allocation);
 
 	/** destructor, delete all vertices and edges
 	only vertices stored in map
 	no pointers to edges created by graph */
-	~Graph();
+	~BasicGraph();
 
 	/** return number of vertices */
 	int getNumVertices() const;
@@ -35,32 +112,93 @@ public:
 	/** return number of edges */
 	int getNumEdges() const;
 
+	/** return how the edge weights are spread, kept up to date by add
+	and readFile, see weightprofile.h */
+	const WeightProfile<Weight>& getWeightProfile() const;
+
 	/** add a new edge between start and end vertex
 	if the vertices do not exist, create them
 	calls Vertex::connect
 	a vertex cannot connect to itself
-	or have multiple edges to another vertex */
-	bool add(std::string start, std::string end, int edgeWeight = 0);
+	or have multiple edges to another vertex
+	returns false if a new vertex would be more than MAX_VERTICES,
+	the graph already has MAX_EDGES edges or the weight is NaN or
+	infinite */
+	bool add(std::string_view start, std::string_view end,
+		Weight edgeWeight = 0);
+
+	/** add a batch of edges, each between the vertices labelled
+	edgeLabels[edge.from] and edgeLabels[edge.to]
+	if the vertices do not exist, create them, every label is looked
+	up once. The batch is sorted so the edges of each vertex go into
+	its adjacency list in order. An edge already in the graph, or
+	earlier in the batch, keeps its first weight and is counted once.
+	returns false, adding nothing, if an index is past the end of
+	edgeLabels, a weight is NaN or infinite, the distinct new labels
+	would be more than MAX_VERTICES or the distinct edges of the batch,
+	were they all new, more than MAX_EDGES */
+	bool addEdges(const std::vector<std::string>& edgeLabels,
+		const std::vector<EdgeRecord>& edges);
 
 	/** return weight of the edge between start and end
-	returns INT_MAX if not connected or vertices don't exist */
-	int getEdgeWeight(std::string start, std::string end);
+	returns NO_EDGE if not connected or vertices don't exist */
+	Weight getEdgeWeight(std::string_view start, std::string_view end) const;
 
 	/** read edges from file
 	the first line of the file is an integer, indicating number of edges
-	each edge line is in the form of "string string int"
-	fromVertex  toVertex    edgeWeight */
-	void readFile(std::string filename);
+	each edge line is in the form of "string string weight"
+	fromVertex  toVertex    edgeWeight
+	the file is memory-mapped and the graph is built in one pass
+	a malformed line is reported on cerr and nothing is added
+	threads is how many threads parse large files, 0 uses every core
+	@return  True if the whole file was read. */
+	bool readFile(std::string filename, unsigned threads = 1);
 
 	/** depth-first traversal starting from startLabel
 	call the function visit on each vertex label */
-	void depthFirstTraversal(std::string startLabel,
-		void visit(const std::string&));
+	void depthFirstTraversal(std::string_view startLabel,
+		void visit(const std::string&)) const;
+
+	/** depth-first traversal keeping its visited state in workspace
+	a reused workspace needs no O(V) clearing between queries */
+	void depthFirstTraversal(std::string_view startLabel,
+		void visit(const std::string&), Workspace& workspace) const;
 
 	/** breadth-first traversal starting from startLabel
 	call the function visit on each vertex label */
-	void breadthFirstTraversal(std::string startLabel,
-		void visit(const std::string&));
+	void breadthFirstTraversal(std::string_view startLabel,
+		void visit(const std::string&)) const;
+
+	/** breadth-first traversal keeping its visited state in workspace */
+	void breadthFirstTraversal(std::string_view startLabel,
+		void visit(const std::string&), Workspace& workspace) const;
+
+	/** depth-first traversal starting from startLabel, in the same order
+	visit(label, depth) is called on each vertex and returns a Visit,
+	or nothing to always continue, see CsrGraph::depthFirstTraversal
+	@return  False if visit stopped the traversal. */
+	template <typename Visitor>
+	bool depthFirstTraversal(std::string_view startLabel, Visitor&& visit)
+		const;
+
+	/** depth-first traversal with a visitor keeping its state in
+	workspace */
+	template <typename Visitor>
+	bool depthFirstTraversal(std::string_view startLabel, Visitor&& visit,
+		Workspace& workspace) const;
+
+	/** breadth-first traversal starting from startLabel, in the same
+	order, visit(label, depth) as for depthFirstTraversal
+	@return  False if visit stopped the traversal. */
+	template <typename Visitor>
+	bool breadthFirstTraversal(std::string_view startLabel, Visitor&& visit)
+		const;
+
+	/** breadth-first traversal with a visitor keeping its state in
+	workspace */
+	template <typename Visitor>
+	bool breadthFirstTraversal(std::string_view startLabel, Visitor&& visit,
+		Workspace& workspace) const;
 
 	/** find the lowest cost from startLabel to all vertices that 
 	can be reached
@@ -69,72 +207,271 @@ public:
 	weight["F"] = 10 indicates the cost to get to "F" is 10
 	record the shortest path to each vertex using given map previous
 	previous["F"] = "C" indicates get to "F" via "C"
+	runs on the CSR snapshot in O((V + E) log V)
 
 	cpplint gives warning to use pointer instead of a non-const map
 	which I am ignoring for readability */
 	void djikstraCostToAllVertices(
-		std::string startLabel,
-		std::map<std::string, int>& weight,
-		std::map<std::string, std::string>& previous);
+		std::string_view startLabel,
+		std::map<std::string, Cost>& weight,
+		std::map<std::string, std::string>& previous) const;
+
+	/** djikstraCostToAllVertices keeping its state in workspace
+	workspace.stats holds the counters of the search, see
+	searchstats.h. With the tree cache on, the tree comes from
+	shortestPathTree and is only copied into the maps. */
+	void djikstraCostToAllVertices(
+		std::string_view startLabel,
+		std::map<std::string, Cost>& weight,
+		std::map<std::string, std::string>& previous,
+		Workspace& workspace) const;
+
+	/** return the shortest-path tree from startLabel, the same costs
+	and parents djikstraCostToAllVertices finds, nullptr if startLabel
+	does not exist
+	With the tree cache on a tree found before is returned without
+	searching again, and a new one is cached. The tree is shared, not
+	copied, and stays valid after the graph changes. */
+	std::shared_ptr<const ShortestPathTree> shortestPathTree(
+		std::string_view startLabel) const;
+
+	/** shortestPathTree keeping its state in workspace, the counters in
+	workspace.stats are 0 when the tree was cached */
+	std::shared_ptr<const ShortestPathTree> shortestPathTree(
+		std::string_view startLabel, Workspace& workspace) const;
+
+	/** keep up to budget bytes of shortest-path trees, least recently
+	used trees go first, 0 turns the cache off and empties it */
+	void setTreeCacheBudget(size_t budget);
+
+	/** return the tree cache, for its size and hit, miss and eviction
+	counters */
+	const TreeCache& getTreeCache() const;
+
+	/** keep the shortest-path tree from startLabel up to date from now
+	on, add and readFile repair it for every edge they add
+	returns the tree, which belongs to the graph, or nullptr if
+	startLabel does not exist. Tracking a source again returns the
+	same tree. */
+	const DynamicTree* trackSource(std::string_view startLabel);
+
+	/** stop keeping the tree of startLabel, the tree is deleted
+	@return  False if startLabel was not tracked. */
+	bool untrackSource(std::string_view startLabel);
+
+	/** same maps as djikstraCostToAllVertices, found by delta-stepping
+	over threads threads, 0 uses every core
+	delta is the bucket width, 0 uses the average edge weight, see
+	CsrGraph::deltaSteppingTree */
+	void deltaSteppingCostToAllVertices(
+		std::string_view startLabel,
+		std::map<std::string, Cost>& weight,
+		std::map<std::string, std::string>& previous, Cost delta = 0,
+		unsigned threads = 0) const;
+
+	/** return the lowest cost from start to target
+	returns UNREACHABLE if target cannot be reached
+	stops as soon as target is settled instead of finding the
+	costs to all vertices
+	path is filled with the labels from start to target */
+	Cost shortestPath(std::string_view start, std::string_view target,
+		std::vector<std::string>& path) const;
+
+	/** shortestPath keeping its state in workspace */
+	Cost shortestPath(std::string_view start, std::string_view target,
+		std::vector<std::string>& path, Workspace& workspace) const;
+
+	/** same cost as shortestPath, A* search guided by heuristic
+	heuristic(label) returns a lower bound on the cost from the vertex
+	with that label to target, see CsrGraph::aStarPath */
+	template <typename Heuristic>
+	Cost aStarPath(std::string_view start, std::string_view target,
+		std::vector<std::string>& path, Heuristic&& heuristic) const;
+
+	/** aStarPath keeping its state in workspace */
+	template <typename Heuristic>
+	Cost aStarPath(std::string_view start, std::string_view target,
+		std::vector<std::string>& path, Heuristic&& heuristic,
+		Workspace& workspace) const;
+
+	/** same result as shortestPath, searches from both ends at once
+	the backward search follows edges from their end vertex */
+	Cost bidirectionalShortestPath(std::string_view start,
+		std::string_view target, std::vector<std::string>& path) const;
+
+	/** bidirectionalShortestPath keeping its state in workspace */
+	Cost bidirectionalShortestPath(std::string_view start,
+		std::string_view target, std::vector<std::string>& path,
+		Workspace& workspace) const;
+
+	/** return an immutable CSR snapshot of the graph
+	vertices get dense integer ids and edges are stored in
+	contiguous arrays, see csrgraph.h */
+	Snapshot freeze() const;
+
+	/** write the graph to filename as a binary CSR snapshot
+	CsrGraph::openBinary maps the file and answers queries from it
+	without reading the text file again
+	@return  True if the whole file was written. */
+	bool saveBinary(const std::string& filename) const;
 	
 private:
+	/** the snapshot reads vertices directly when it is built */
+	friend class BasicCsrGraph<Weight, VertexId>;
 
-	/** used as an alternative comparison for priority queue */
-	struct myComparison {
-		bool operator()(pair<string, int> const & n1,
-		 pair<string, int> const & n2) const noexcept {
-			return n1.second > n2.second;
-		}
-	};
+	/** tracked trees search the adjacency lists and labels directly */
+	friend class BasicDynamicTree<Weight, VertexId>;
+
+	/** size of the first arena slab, later slabs grow from it */
+	static constexpr size_t ARENA_SLAB = 1 << 16;
 
 	/** number of vertices in graph */
 	int numberOfVertices;
 
-	/** number of edges in graph */
+	/** number of edges in graph, an edge added twice is counted once */
 	int numberOfEdges;
 
-	/** mapping from vertex label to vertex pointer for quick access */
-	std::map<std::string, Vertex*> vertices;
+	/** weights of the edges in graph, an edge added twice keeps its
+	first weight and is counted once */
+	WeightProfile<Weight> weightProfile;
+
+	/** slabs everything is allocated from, nullptr for HEAP */
+	std::unique_ptr<std::pmr::monotonic_buffer_resource> arena;
 
-	/** mark all verticies as unvisited */
-	void unvisitVertices();
+	/** arena, or the heap if there is no arena */
+	std::pmr::memory_resource* memory;
+
+	/** every vertex label, stored once
+	only vertices are interned, so the handles are 0 to V - 1 */
+	LabelPool labels;
+
+	/** vertex pointer by label handle for quick access */
+	std::pmr::vector<BasicVertex<Weight>*> vertices;
 
 	/** find a vertex, if it does not exist return nullptr */
-	Vertex* findVertex(const std::string& vertexLabel);
+	BasicVertex<Weight>* findVertex(std::string_view vertexLabel) const;
 
-	/** find a vertex, if it does not exist create it and return it */
-	Vertex* findOrCreateVertex(const std::string& vertexLabel);
+	/** find a vertex, if it does not exist create it and return it
+	returns nullptr if the graph already has MAX_VERTICES vertices */
+	BasicVertex<Weight>* findOrCreateVertex(std::string_view vertexLabel);
 
+	/** snapshot used by the queries, nullptr when it needs rebuilding
+	add() throws it away so it never shows a stale graph */
+	mutable std::unique_ptr<Snapshot> snapshot;
 
-	/** Helper functions for Dijkstra's path **/
-	
-	/** fills the weight map */
-	void getWeight(Vertex * find, string startLabel,
-	 priority_queue<pair<string, int>, vector<pair<string, int>>,
-		 myComparison>&pq, std::map<std::string, int>& weight,
-			 std::map<std::string, std::string>& previous);
-	
-	/** fills the previous map */
-	void getPrevious(Vertex * find, string startLabel,
-		 std::map<std::string, std::string>& previous);
+	/** held while the snapshot is checked or built, so const queries
+	from several threads build it only once */
+	mutable std::mutex snapshotLock;
 
-	/** helps weight function calculate the total weight */
-	int calculateWeight(std::map<std::string, int>& weight, string start);
+	/** return the snapshot, building it if the graph has changed */
+	const Snapshot& getSnapshot() const;
 
-	/** removes a weight from the weight map if a lower weight to the
-	 same vertex is found */
-	void removeWeight(std::map<std::string, int>& weight, string remove);
-	
-	/** removes the previous values from the map if the weight values
-	 are removed */
-	void removePrevious(std::map<std::string, string>& previous,
-	 string remove);
-	
-	/** Checks if a value has already been added into the map */
-	void findDuplicates(std::map<std::string, int>& weight, string find,
-	 int challenger, std::map<std::string, string>& previous);
+	/** trees found by shortestPathTree, cleared with the snapshot */
+	mutable TreeCache treeCache;
+
+	/** trees of the sources passed to trackSource by label handle */
+	std::map<LabelPool::Label, std::unique_ptr<DynamicTree>> trackedTrees;
+
+
+};  // end BasicGraph
+
+/** depth-first traversal starting from startLabel, visit gets labels */
+template <typename Weight, typename VertexId>
+template <typename Visitor>
+bool BasicGraph<Weight, VertexId>::depthFirstTraversal(
+	std::string_view startLabel, Visitor&& visit) const
+{
+	Workspace workspace;
+	return depthFirstTraversal(startLabel, visit, workspace);
+}
+
+/** depth-first traversal with a visitor keeping its state in workspace */
+template <typename Weight, typename VertexId>
+template <typename Visitor>
+bool BasicGraph<Weight, VertexId>::depthFirstTraversal(
+	std::string_view startLabel, Visitor&& visit,
+	Workspace& workspace) const
+{
+	const Snapshot& csr = getSnapshot();
+	VertexId start = csr.findVertex(startLabel);
+	if (start == Snapshot::NO_VERTEX) {
+		return true;
+	}
+
+	return csr.depthFirstTraversal(start,
+		[&](VertexId id, uint32_t depth) {
+			return visit(csr.getLabel(id), depth);
+		}, workspace);
+}
+
+/** breadth-first traversal starting from startLabel, visit gets labels */
+template <typename Weight, typename VertexId>
+template <typename Visitor>
+bool BasicGraph<Weight, VertexId>::breadthFirstTraversal(
+	std::string_view startLabel, Visitor&& visit) const
+{
+	Workspace workspace;
+	return breadthFirstTraversal(startLabel, visit, workspace);
+}
+
+/** breadth-first traversal with a visitor keeping its state in workspace */
+template <typename Weight, typename VertexId>
+template <typename Visitor>
+bool BasicGraph<Weight, VertexId>::breadthFirstTraversal(
+	std::string_view startLabel, Visitor&& visit,
+	Workspace& workspace) const
+{
+	const Snapshot& csr = getSnapshot();
+	VertexId start = csr.findVertex(startLabel);
+	if (start == Snapshot::NO_VERTEX) {
+		return true;
+	}
+
+	return csr.breadthFirstTraversal(start,
+		[&](VertexId id, uint32_t depth) {
+			return visit(csr.getLabel(id), depth);
+		}, workspace);
+}
+
+/** A* search from start to target, heuristic gets labels */
+template <typename Weight, typename VertexId>
+template <typename Heuristic>
+typename BasicGraph<Weight, VertexId>::Cost
+BasicGraph<Weight, VertexId>::aStarPath(std::string_view start,
+	std::string_view target, std::vector<std::string>& path,
+	Heuristic&& heuristic) const
+{
+	Workspace workspace;
+	return aStarPath(start, target, path, heuristic, workspace);
+}
+
+/** A* search keeping its state in workspace */
+template <typename Weight, typename VertexId>
+template <typename Heuristic>
+typename BasicGraph<Weight, VertexId>::Cost
+BasicGraph<Weight, VertexId>::aStarPath(std::string_view start,
+	std::string_view target, std::vector<std::string>& path,
+	Heuristic&& heuristic, Workspace& workspace) const
+{
+	path.clear();
+	const Snapshot& csr = getSnapshot();
+	VertexId from = csr.findVertex(start);
+	VertexId to = csr.findVertex(target);
+	if (from == Snapshot::NO_VERTEX || to == Snapshot::NO_VERTEX) {
+		return UNREACHABLE;
+	}
 
+	std::vector<VertexId> ids;
+	Cost cost = csr.aStarPath(from, to, ids,
+		[&](VertexId id) { return heuristic(csr.getLabel(id)); },
+		workspace);
+	for (VertexId id : ids) {
+		path.emplace_back(csr.getLabel(id));
+	}
+	return cost;
+}
 
-};  // end Graph
+/** graph with int weights */
+typedef BasicGraph<int, uint32_t> Graph;
 
 #endif  // GRAPH_H
@@ -0,0 +1,211 @@
+/**
+* Synthetic graphs for benchmarks and tests
+* Every generator is deterministic for a given seed.
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "graphgen.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// This is 80 characters - Keep all lines under 80 characters                 //
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/** add the edges from - to and to - from with the same weight */
+void addBothWays(GeneratedGraph& graph, uint32_t from, uint32_t to,
+	int weight)
+{
+	graph.edges.push_back(EdgeFile::Record{ from, to, weight });
+	graph.edges.push_back(EdgeFile::Record{ to, from, weight });
+}
+
+}  // namespace
+
+/** label of vertex id in a generated graph, "v" followed by id */
+std::string vertexLabel(uint32_t id)
+{
+	return "v" + std::to_string(id);
+}
+
+/** R-MAT graph with 2^scale vertices and edgeFactor * 2^scale edges */
+GeneratedGraph generateRmat(unsigned scale, unsigned edgeFactor,
+	uint32_t seed)
+{
+	// Graph500 quadrant probabilities, d is what is left
+	const double a = 0.57;
+	const double b = 0.19;
+	const double c = 0.19;
+
+	std::mt19937 random(seed);
+	std::uniform_real_distribution<double> unit(0.0, 1.0);
+	std::uniform_int_distribution<int> weight(1, 100);
+
+	GeneratedGraph graph;
+	graph.numVertices = static_cast<uint32_t>(1) << scale;
+	uint64_t numEdges = static_cast<uint64_t>(edgeFactor) << scale;
+	graph.edges.reserve(numEdges);
+
+	// ids are shuffled so high degree vertices are not all at the start
+	std::vector<uint32_t> shuffled(graph.numVertices);
+	std::iota(shuffled.begin(), shuffled.end(), 0);
+	std::shuffle(shuffled.begin(), shuffled.end(), random);
+
+	for (uint64_t e = 0; e < numEdges; ++e) {
+		uint32_t from = 0;
+		uint32_t to = 0;
+		for (unsigned bit = 0; bit < scale; ++bit) {
+			double r = unit(random);
+			from = from << 1 | (r >= a + b ? 1 : 0);
+			to = to << 1 | ((r >= a && r < a + b) || r >= a + b + c ? 1 : 0);
+		}
+		if (from != to) {
+			graph.edges.push_back(EdgeFile::Record{ shuffled[from],
+				shuffled[to], weight(random) });
+		}
+	}
+	return graph;
+}
+
+/** rows x cols grid, each vertex joined both ways to its right and
+lower neighbor */
+GeneratedGraph generateGrid(uint32_t rows, uint32_t cols, uint32_t seed)
+{
+	std::mt19937 random(seed);
+	std::uniform_int_distribution<int> weight(1, 100);
+
+	GeneratedGraph graph;
+	graph.numVertices = rows * cols;
+	graph.edges.reserve(4 * static_cast<size_t>(graph.numVertices));
+	for (uint32_t row = 0; row < rows; ++row) {
+		for (uint32_t col = 0; col < cols; ++col) {
+			uint32_t v = row * cols + col;
+			if (col + 1 < cols) {
+				addBothWays(graph, v, v + 1, weight(random));
+			}
+			if (row + 1 < rows) {
+				addBothWays(graph, v, v + cols, weight(random));
+			}
+		}
+	}
+	return graph;
+}
+
+/** random geometric graph of numVertices points with about
+averageDegree edges out of each */
+GeneratedGraph generateGeometric(uint32_t numVertices,
+	double averageDegree, uint32_t seed)
+{
+	std::mt19937 random(seed);
+	std::uniform_real_distribution<double> unit(0.0, 1.0);
+
+	GeneratedGraph graph;
+	graph.numVertices = numVertices;
+	if (numVertices == 0) {
+		return graph;
+	}
+
+	// a circle of this radius holds averageDegree points on average
+	const double pi = 3.14159265358979323846;
+	double radius = std::sqrt(averageDegree / (pi * numVertices));
+	std::vector<double> x(numVertices);
+	std::vector<double> y(numVertices);
+	for (uint32_t v = 0; v < numVertices; ++v) {
+		x[v] = unit(random);
+		y[v] = unit(random);
+	}
+
+	// cells as wide as the radius, so close points are in the same or
+	// a neighboring cell
+	uint32_t side = static_cast<uint32_t>(std::max(1.0,
+		std::min(4096.0, std::floor(1.0 / radius))));
+	auto cellOf = [side](double position) {
+		return std::min(side - 1, static_cast<uint32_t>(position * side));
+	};
+	std::vector<std::vector<uint32_t>> cells(
+		static_cast<size_t>(side) * side);
+	for (uint32_t v = 0; v < numVertices; ++v) {
+		cells[cellOf(y[v]) * side + cellOf(x[v])].push_back(v);
+	}
+
+	graph.edges.reserve(static_cast<size_t>(averageDegree * numVertices));
+	for (uint32_t v = 0; v < numVertices; ++v) {
+		uint32_t cellX = cellOf(x[v]);
+		uint32_t cellY = cellOf(y[v]);
+		for (uint32_t cy = cellY == 0 ? 0 : cellY - 1;
+			cy <= std::min(side - 1, cellY + 1); ++cy) {
+			for (uint32_t cx = cellX == 0 ? 0 : cellX - 1;
+				cx <= std::min(side - 1, cellX + 1); ++cx) {
+				for (uint32_t w : cells[cy * side + cx]) {
+					double distance = std::hypot(x[v] - x[w], y[v] - y[w]);
+					if (w > v && distance < radius) {
+						addBothWays(graph, v, w,
+							1 + static_cast<int>(distance * 1000));
+					}
+				}
+			}
+		}
+	}
+	return graph;
+}
+
+/** preferential attachment graph, each new vertex is joined both ways
+to edgesPerVertex earlier vertices */
+GeneratedGraph generatePowerLaw(uint32_t numVertices,
+	unsigned edgesPerVertex, uint32_t seed)
+{
+	std::mt19937 random(seed);
+	std::uniform_int_distribution<int> weight(1, 100);
+
+	GeneratedGraph graph;
+	graph.numVertices = numVertices;
+	graph.edges.reserve(2 * static_cast<size_t>(numVertices) *
+		edgesPerVertex);
+
+	// every vertex appears once per edge it has, so a uniform pick
+	// from this list picks a vertex in proportion to its degree
+	// all earlier vertices are in it, so wanted targets always exist
+	std::vector<uint32_t> ends;
+	std::vector<uint32_t> picked;
+	for (uint32_t v = 1; v < numVertices; ++v) {
+		unsigned wanted = std::min<unsigned>(edgesPerVertex, v);
+		picked.clear();
+		while (picked.size() < wanted) {
+			uint32_t target = ends.empty() ? 0 : ends[
+				std::uniform_int_distribution<size_t>(0,
+					ends.size() - 1)(random)];
+			if (std::find(picked.begin(), picked.end(), target) ==
+				picked.end()) {
+				picked.push_back(target);
+			}
+		}
+
+		for (uint32_t target : picked) {
+			addBothWays(graph, v, target, weight(random));
+			ends.push_back(v);
+			ends.push_back(target);
+		}
+	}
+	return graph;
+}
+
+/** write graph to filename in the edge file format Graph::readFile
+reads */
+bool writeEdgeFile(const GeneratedGraph& graph, const std::string& filename)
+{
+	std::ofstream fout(filename, std::ios::trunc);
+	fout << graph.edges.size() << '\n';
+	for (const EdgeFile::Record& edge : graph.edges) {
+		fout << 'v' << edge.from << " v" << edge.to << ' ' << edge.weight
+			<< '\n';
+	}
+	fout.close();
+	return static_cast<bool>(fout);
+}
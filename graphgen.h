@@ -0,0 +1,62 @@
+/**
+* Synthetic graphs for benchmarks and tests
+* Every generator is deterministic for a given seed. Vertices are
+* numbered 0 .. numVertices - 1 and get the label vertexLabel(id), edges
+* are EdgeFile records so a generated graph can be written as an edge
+* file or added to a Graph one edge at a time.
+* R-MAT      recursive matrix graph as used by Graph500, skewed degrees
+*            and small diameter, like social and web graphs
+* grid       rows x cols grid, edges both ways between neighbors, large
+*            diameter like road networks
+* geometric  random points in the unit square joined when closer than a
+*            radius, edges both ways weighted by distance
+* power-law  preferential attachment, a few hubs with very high degree
+*/
+
+#ifndef GRAPHGEN_H
+#define GRAPHGEN_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "edgefile.h"
+
+/** vertices and edges of a generated graph */
+struct GeneratedGraph {
+	uint32_t numVertices{ 0 };
+	std::vector<EdgeFile::Record> edges;
+};
+
+/** label of vertex id in a generated graph, "v" followed by id */
+std::string vertexLabel(uint32_t id);
+
+/** R-MAT graph with 2^scale vertices and edgeFactor * 2^scale edges
+drawn with the Graph500 probabilities, weights 1 to 100
+self loops are dropped, repeated edges are kept */
+GeneratedGraph generateRmat(unsigned scale, unsigned edgeFactor,
+	uint32_t seed = 1);
+
+/** rows x cols grid, each vertex joined both ways to the vertex on its
+right and below it, weights 1 to 100 */
+GeneratedGraph generateGrid(uint32_t rows, uint32_t cols,
+	uint32_t seed = 1);
+
+/** random geometric graph of numVertices points with about
+averageDegree edges out of each, weight is 1 plus the distance
+times 1000 */
+GeneratedGraph generateGeometric(uint32_t numVertices,
+	double averageDegree, uint32_t seed = 1);
+
+/** preferential attachment graph, each new vertex is joined both ways
+to edgesPerVertex earlier vertices picked in proportion to their
+degree, weights 1 to 100 */
+GeneratedGraph generatePowerLaw(uint32_t numVertices,
+	unsigned edgesPerVertex, uint32_t seed = 1);
+
+/** write graph to filename in the edge file format Graph::readFile
+reads
+@return  True if the whole file was written. */
+bool writeEdgeFile(const GeneratedGraph& graph, const std::string& filename);
+
+#endif  // GRAPHGEN_H
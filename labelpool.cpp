@@ -0,0 +1,72 @@
+/**
+* Stores every vertex label once and hands out small integer handles
+* Text is copied into large blocks, a label longer than a block gets a
+* block of its own.
+*/
+
+#include <algorithm>
+#include <cstring>
+
+#include "labelpool.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// This is 80 characters - Keep all lines under 80 characters                 //
+////////////////////////////////////////////////////////////////////////////////
+
+/** constructor, empty pool */
+LabelPool::LabelPool(std::pmr::memory_resource* memory)
+	: memory(memory), views(memory), index(memory), blocks(memory)
+{
+}
+
+/** destructor, frees the label text */
+LabelPool::~LabelPool()
+{
+	for (const std::pair<char*, size_t>& block : blocks) {
+		memory->deallocate(block.first, block.second, 1);
+	}
+}
+
+/** return the handle of text, adding it if it is not in the pool */
+LabelPool::Label LabelPool::intern(std::string_view text)
+{
+	auto found = index.find(text);
+	if (found != index.end()) {
+		return found->second;
+	}
+
+	Label label = static_cast<Label>(views.size());
+	std::string_view stored(store(text), text.size());
+	views.push_back(stored);
+	index.emplace(stored, label);
+	numBytes += text.size();
+	return label;
+}
+
+/** return the handle of text, NO_LABEL if it is not in the pool */
+LabelPool::Label LabelPool::find(std::string_view text) const
+{
+	auto found = index.find(text);
+	if (found == index.end()) {
+		return NO_LABEL;
+	}
+	return found->second;
+}
+
+/** copy text into the current block, starting a new one if full */
+const char* LabelPool::store(std::string_view text)
+{
+	if (text.size() > spareBytes || spare == nullptr) {
+		size_t blockBytes = std::max(CHUNK, text.size());
+		char* block = static_cast<char*>(memory->allocate(blockBytes, 1));
+		blocks.emplace_back(block, blockBytes);
+		spare = block;
+		spareBytes = blockBytes;
+	}
+
+	char* stored = spare;
+	std::memcpy(stored, text.data(), text.size());
+	spare += text.size();
+	spareBytes -= text.size();
+	return stored;
+}
@@ -0,0 +1,81 @@
+/**
+* Stores every vertex label once and hands out small integer handles
+* The graph, the vertices and the adjacency lists keep handles instead of
+* their own copies of the label text, so two labels are the same label
+* exactly when their handles are equal.
+* Handles are given out in the order labels are first interned. The text
+* of a label never moves, so views of it stay valid as long as the pool.
+*/
+
+#ifndef LABELPOOL_H
+#define LABELPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+class LabelPool {
+public:
+	/** handle of an interned label */
+	typedef uint32_t Label;
+
+	/** returned by find if the label was never interned */
+	static constexpr Label NO_LABEL = UINT32_MAX;
+
+	/** constructor, empty pool
+	label text and the index are allocated from memory */
+	explicit LabelPool(
+		std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+	/** destructor, frees the label text */
+	~LabelPool();
+
+	LabelPool(const LabelPool&) = delete;
+	LabelPool& operator=(const LabelPool&) = delete;
+
+	/** return the handle of text, adding it if it is not in the pool */
+	Label intern(std::string_view text);
+
+	/** return the handle of text, NO_LABEL if it is not in the pool */
+	Label find(std::string_view text) const;
+
+	/** return the text of label, valid as long as the pool */
+	std::string_view view(Label label) const { return views[label]; }
+
+	/** return number of labels */
+	size_t size() const { return views.size(); }
+
+	/** return number of bytes of label text */
+	size_t getNumBytes() const { return numBytes; }
+
+private:
+	/** size of the blocks label text is copied into */
+	static constexpr size_t CHUNK = 1 << 14;
+
+	/** copy text into the current block, starting a new one if full */
+	const char* store(std::string_view text);
+
+	/** where blocks come from */
+	std::pmr::memory_resource* memory;
+
+	/** text of each label, indexed by handle */
+	std::pmr::vector<std::string_view> views;
+
+	/** handle of each label, the keys point at the text in the blocks */
+	std::pmr::unordered_map<std::string_view, Label> index;
+
+	/** every block with its size, freed by the destructor */
+	std::pmr::vector<std::pair<char*, size_t>> blocks;
+
+	/** unused part of the last block */
+	char* spare{ nullptr };
+	size_t spareBytes{ 0 };
+
+	/** bytes of label text stored */
+	size_t numBytes{ 0 };
+};  // end LabelPool
+
+#endif  // LABELPOOL_H
@@ -0,0 +1,373 @@
+/**
+* ALT, A* with landmarks and the triangle inequality
+* A landmark file is a Header followed by the landmark ids, then the
+* fromLandmark and the toLandmark table, all in native byte order.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "landmarks.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// This is 80 characters - Keep all lines under 80 characters                 //
+////////////////////////////////////////////////////////////////////////////////
+
+namespace {
+
+/** first bytes of every landmark file */
+const char MAGIC[8] = { 'L', 'A', 'N', 'D', 'M', 'A', 'R', 'K' };
+
+/** bumped whenever the layout changes */
+const uint32_t VERSION = 1;
+
+/** written in native byte order, tells if a file was written on a
+machine with a different byte order */
+const uint32_t ENDIAN_MARK = 0x01020304;
+
+/** start of a landmark file, the ids and tables follow it */
+struct Header {
+	char magic[8];
+	uint32_t version;
+	uint32_t byteOrder;
+	uint32_t costType;
+	uint32_t idType;
+	uint64_t numVertices;
+	uint64_t numLandmarks;
+	uint64_t fingerprint;
+};
+
+/** size of T, 0x100 added for floating point and 0x200 for signed
+types, the same codes the snapshot header uses */
+template <typename T>
+uint32_t typeCode()
+{
+	return static_cast<uint32_t>(sizeof(T)) +
+		(std::is_floating_point<T>::value ? 0x100 : 0) +
+		(std::is_signed<T>::value ? 0x200 : 0);
+}
+
+/** FNV-1a hash of size bytes at data, continuing from hash */
+uint64_t hashBytes(uint64_t hash, const void* data, size_t size)
+{
+	const unsigned char* bytes = static_cast<const unsigned char*>(data);
+	for (size_t i = 0; i < size; ++i) {
+		hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+	}
+	return hash;
+}
+
+/** hash of the edges of graph, with their weights, in id order */
+template <typename Weight, typename VertexId>
+uint64_t fingerprintOf(const BasicCsrGraph<Weight, VertexId>& graph)
+{
+	uint64_t hash = 0xcbf29ce484222325ULL;
+	for (VertexId v = 0; v < static_cast<VertexId>(graph.getNumVertices());
+		++v) {
+		uint32_t degree = graph.edgesEnd(v) - graph.edgesBegin(v);
+		hash = hashBytes(hash, &degree, sizeof(degree));
+		for (uint32_t e = graph.edgesBegin(v); e < graph.edgesEnd(v); ++e) {
+			VertexId target = graph.getTarget(e);
+			Weight weight = graph.getWeight(e);
+			hash = hashBytes(hash, &target, sizeof(target));
+			hash = hashBytes(hash, &weight, sizeof(weight));
+		}
+	}
+	return hash;
+}
+
+/** cost[v] is the lowest cost from v to target, UNREACHABLE if target
+cannot be reached, Dijkstra over the incoming edges */
+template <typename Weight, typename VertexId>
+void costsTo(const BasicCsrGraph<Weight, VertexId>& graph, VertexId target,
+	std::vector<typename WeightTraits<Weight>::Cost>& cost)
+{
+	typedef typename WeightTraits<Weight>::Cost Cost;
+	typedef std::pair<Cost, VertexId> HeapEntry;
+
+	cost.assign(graph.getNumVertices(), WeightTraits<Weight>::UNREACHABLE);
+	std::vector<HeapEntry> heap;
+	cost[target] = 0;
+	heap.emplace_back(0, target);
+	while (!heap.empty()) {
+		std::pop_heap(heap.begin(), heap.end(), std::greater<HeapEntry>());
+		HeapEntry smallest = heap.back();
+		heap.pop_back();
+		VertexId vertex = smallest.second;
+		if (smallest.first > cost[vertex]) {
+			continue;
+		}
+		for (uint32_t e = graph.reverseEdgesBegin(vertex);
+			e < graph.reverseEdgesEnd(vertex); ++e) {
+			VertexId neighbor = graph.getSource(e);
+			Cost challenger = WeightTraits<Weight>::add(smallest.first,
+				graph.getReverseWeight(e));
+			if (challenger < cost[neighbor]) {
+				cost[neighbor] = challenger;
+				heap.emplace_back(challenger, neighbor);
+				std::push_heap(heap.begin(), heap.end(),
+					std::greater<HeapEntry>());
+			}
+		}
+	}
+}
+
+/** lower nearest[v] to the finite costs in from[v] and to[v] */
+template <typename Cost>
+void updateNearest(std::vector<Cost>& nearest, const std::vector<Cost>& from,
+	const std::vector<Cost>& to, Cost unreachable)
+{
+	for (size_t v = 0; v < nearest.size(); ++v) {
+		if (from[v] != unreachable) {
+			nearest[v] = std::min(nearest[v], from[v]);
+		}
+		if (to[v] != unreachable) {
+			nearest[v] = std::min(nearest[v], to[v]);
+		}
+	}
+}
+
+}  // namespace
+
+/** constructor, no landmarks */
+template <typename Weight, typename VertexId>
+BasicLandmarks<Weight, VertexId>::BasicLandmarks()
+{
+}
+
+/** pick up to count landmarks farthest-first and fill the tables */
+template <typename Weight, typename VertexId>
+void BasicLandmarks<Weight, VertexId>::build(const Snapshot& graph,
+	unsigned count)
+{
+	numVertices = static_cast<uint32_t>(graph.getNumVertices());
+	fingerprint = fingerprintOf(graph);
+	landmarks.clear();
+	fromLandmark.clear();
+	toLandmark.clear();
+	if (numVertices == 0) {
+		return;
+	}
+
+	// nearest[v] is the lowest cost between v and a landmark either
+	// way, vertex 0 stands in until the first landmark is picked
+	std::vector<Cost> nearest(numVertices, UNREACHABLE);
+	std::vector<std::vector<Cost>> from;
+	std::vector<std::vector<Cost>> to;
+	std::vector<Cost> forward;
+	std::vector<Cost> backward;
+	std::vector<VertexId> parent;
+	Workspace workspace;
+	graph.shortestPathTree(0, forward, parent, workspace);
+	costsTo(graph, static_cast<VertexId>(0), backward);
+	updateNearest(nearest, forward, backward, UNREACHABLE);
+
+	while (landmarks.size() < count) {
+		VertexId farthest = 0;
+		Cost distance = 0;
+		for (VertexId v = 0; v < numVertices; ++v) {
+			if (nearest[v] != UNREACHABLE && nearest[v] > distance) {
+				farthest = v;
+				distance = nearest[v];
+			}
+		}
+		if (!(distance > 0)) {
+			break;
+		}
+
+		landmarks.push_back(farthest);
+		from.emplace_back();
+		to.emplace_back();
+		graph.shortestPathTree(farthest, from.back(), parent, workspace);
+		costsTo(graph, farthest, to.back());
+		updateNearest(nearest, from.back(), to.back(), UNREACHABLE);
+	}
+
+	// the costs of one vertex go next to each other, lowerBound reads
+	// them together
+	size_t k = landmarks.size();
+	fromLandmark.resize(size_t(numVertices) * k);
+	toLandmark.resize(size_t(numVertices) * k);
+	for (size_t i = 0; i < k; ++i) {
+		for (uint32_t v = 0; v < numVertices; ++v) {
+			fromLandmark[v * k + i] = from[i][v];
+			toLandmark[v * k + i] = to[i][v];
+		}
+	}
+}
+
+/** write the tables to filename
+@return  True if the whole file was written. */
+template <typename Weight, typename VertexId>
+bool BasicLandmarks<Weight, VertexId>::save(
+	const std::string& filename) const
+{
+	Header header;
+	std::copy(MAGIC, MAGIC + sizeof(MAGIC), header.magic);
+	header.version = VERSION;
+	header.byteOrder = ENDIAN_MARK;
+	header.costType = typeCode<Cost>();
+	header.idType = typeCode<VertexId>();
+	header.numVertices = numVertices;
+	header.numLandmarks = landmarks.size();
+	header.fingerprint = fingerprint;
+
+	std::ofstream fout(filename, std::ios::binary | std::ios::trunc);
+	fout.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	fout.write(reinterpret_cast<const char*>(landmarks.data()),
+		static_cast<std::streamsize>(landmarks.size() * sizeof(VertexId)));
+	fout.write(reinterpret_cast<const char*>(fromLandmark.data()),
+		static_cast<std::streamsize>(fromLandmark.size() * sizeof(Cost)));
+	fout.write(reinterpret_cast<const char*>(toLandmark.data()),
+		static_cast<std::streamsize>(toLandmark.size() * sizeof(Cost)));
+	fout.close();
+	return static_cast<bool>(fout);
+}
+
+/** replace the tables with ones written by save for graph
+@return  False, leaving the tables as they were, if the file does not
+hold tables for graph. */
+template <typename Weight, typename VertexId>
+bool BasicLandmarks<Weight, VertexId>::load(const std::string& filename,
+	const Snapshot& graph)
+{
+	std::ifstream fin(filename, std::ios::binary | std::ios::ate);
+	if (!fin) {
+		return false;
+	}
+	uint64_t fileSize = static_cast<uint64_t>(fin.tellg());
+	fin.seekg(0);
+
+	Header header;
+	if (fileSize < sizeof(header) ||
+		!fin.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+		return false;
+	}
+	uint64_t cells = header.numVertices * header.numLandmarks;
+	if (!std::equal(MAGIC, MAGIC + sizeof(MAGIC), header.magic) ||
+		header.version != VERSION || header.byteOrder != ENDIAN_MARK ||
+		header.costType != typeCode<Cost>() ||
+		header.idType != typeCode<VertexId>() ||
+		header.numVertices != static_cast<uint64_t>(graph.getNumVertices()) ||
+		header.numLandmarks > header.numVertices ||
+		fileSize != sizeof(header) + header.numLandmarks * sizeof(VertexId) +
+		2 * cells * sizeof(Cost)) {
+		return false;
+	}
+
+	// only hash the graph once the file looks right
+	if (header.fingerprint != fingerprintOf(graph)) {
+		return false;
+	}
+
+	std::vector<VertexId> ids(header.numLandmarks);
+	std::vector<Cost> from(cells);
+	std::vector<Cost> to(cells);
+	fin.read(reinterpret_cast<char*>(ids.data()),
+		static_cast<std::streamsize>(ids.size() * sizeof(VertexId)));
+	fin.read(reinterpret_cast<char*>(from.data()),
+		static_cast<std::streamsize>(from.size() * sizeof(Cost)));
+	fin.read(reinterpret_cast<char*>(to.data()),
+		static_cast<std::streamsize>(to.size() * sizeof(Cost)));
+	if (!fin) {
+		return false;
+	}
+	for (VertexId id : ids) {
+		if (id >= header.numVertices) {
+			return false;
+		}
+	}
+
+	numVertices = static_cast<uint32_t>(header.numVertices);
+	fingerprint = header.fingerprint;
+	landmarks.swap(ids);
+	fromLandmark.swap(from);
+	toLandmark.swap(to);
+	return true;
+}
+
+/** return number of landmarks */
+template <typename Weight, typename VertexId>
+unsigned BasicLandmarks<Weight, VertexId>::getNumLandmarks() const
+{
+	return static_cast<unsigned>(landmarks.size());
+}
+
+/** return the vertex id of landmark i */
+template <typename Weight, typename VertexId>
+VertexId BasicLandmarks<Weight, VertexId>::getLandmark(unsigned i) const
+{
+	return landmarks[i];
+}
+
+/** return a lower bound on the cost from vertex from to vertex to
+A cost that is UNREACHABLE gives no bound, unless it shows to cannot be
+reached: landmark i reaches from but not to, or to reaches landmark i
+but from does not. */
+template <typename Weight, typename VertexId>
+typename BasicLandmarks<Weight, VertexId>::Cost
+BasicLandmarks<Weight, VertexId>::lowerBound(VertexId from,
+	VertexId to) const
+{
+	size_t k = landmarks.size();
+	const Cost* fromA = fromLandmark.data() + from * k;
+	const Cost* fromB = fromLandmark.data() + to * k;
+	const Cost* toA = toLandmark.data() + from * k;
+	const Cost* toB = toLandmark.data() + to * k;
+
+	Cost bound = 0;
+	for (size_t i = 0; i < k; ++i) {
+		if (fromA[i] != UNREACHABLE) {
+			if (fromB[i] == UNREACHABLE) {
+				return UNREACHABLE;
+			}
+			if (fromB[i] > fromA[i]) {
+				bound = std::max<Cost>(bound, fromB[i] - fromA[i]);
+			}
+		}
+		if (toB[i] != UNREACHABLE) {
+			if (toA[i] == UNREACHABLE) {
+				return UNREACHABLE;
+			}
+			if (toA[i] > toB[i]) {
+				bound = std::max<Cost>(bound, toA[i] - toB[i]);
+			}
+		}
+	}
+	return bound;
+}
+
+/** A* guided by lowerBound from source to target */
+template <typename Weight, typename VertexId>
+typename BasicLandmarks<Weight, VertexId>::Cost
+BasicLandmarks<Weight, VertexId>::shortestPath(const Snapshot& graph,
+	VertexId source, VertexId target, std::vector<VertexId>& path) const
+{
+	Workspace workspace;
+	return shortestPath(graph, source, target, path, workspace);
+}
+
+/** shortestPath keeping its state in workspace */
+template <typename Weight, typename VertexId>
+typename BasicLandmarks<Weight, VertexId>::Cost
+BasicLandmarks<Weight, VertexId>::shortestPath(const Snapshot& graph,
+	VertexId source, VertexId target, std::vector<VertexId>& path,
+	Workspace& workspace) const
+{
+	return graph.aStarPath(source, target, path,
+		[this, target](VertexId v) { return lowerBound(v, target); },
+		workspace);
+}
+
+// the weight and id types listed in graph.cpp
+template class BasicLandmarks<int, uint32_t>;
+template class BasicLandmarks<uint16_t, uint16_t>;
+template class BasicLandmarks<uint32_t, uint32_t>;
+template class BasicLandmarks<int64_t, uint32_t>;
+template class BasicLandmarks<float, uint32_t>;
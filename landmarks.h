@@ -0,0 +1,109 @@
+/**
+* ALT, A* with landmarks and the triangle inequality
+* A few landmark vertices are picked farthest-first and the lowest cost
+* from every landmark to every vertex and back is stored. For any
+* landmark L the cost from v to t is at least cost(L, t) - cost(L, v)
+* and at least cost(v, L) - cost(t, L), the largest of these bounds
+* guides CsrGraph::aStarPath towards t.
+* The tables belong to one snapshot. save writes them to a file next to
+* the snapshot and load only accepts them for a snapshot with the same
+* vertices, edges and weights, so the preprocessing is done once.
+* Building takes two Dijkstra searches per landmark and the tables take
+* 2 * landmarks * vertices costs.
+*/
+
+#ifndef LANDMARKS_H
+#define LANDMARKS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "csrgraph.h"
+#include "weighttraits.h"
+
+/** Weight and VertexId are those of the snapshot, see csrgraph.h */
+template <typename Weight, typename VertexId>
+class BasicLandmarks {
+public:
+	/** snapshot the tables are built for */
+	typedef BasicCsrGraph<Weight, VertexId> Snapshot;
+
+	/** type path costs are added up in */
+	typedef typename WeightTraits<Weight>::Cost Cost;
+
+	/** per-query state for searches on the snapshot */
+	typedef typename Snapshot::Workspace Workspace;
+
+	/** cost of a vertex that cannot be reached */
+	static constexpr Cost UNREACHABLE = WeightTraits<Weight>::UNREACHABLE;
+
+	/** landmarks build picks when no count is given */
+	static constexpr unsigned DEFAULT_LANDMARKS = 8;
+
+	/** constructor, no landmarks, every lower bound is 0 */
+	BasicLandmarks();
+
+	/** pick up to count landmarks of graph and find the cost from and
+	to each of them, replacing any tables held before
+	The first landmark is the vertex farthest from vertex 0, each next
+	one the vertex farthest from the landmarks picked so far, going
+	both ways. Vertices no landmark reaches or is reached from are
+	never picked, so fewer landmarks are kept when every vertex is
+	already a landmark or next to one at cost 0. */
+	void build(const Snapshot& graph, unsigned count = DEFAULT_LANDMARKS);
+
+	/** write the tables to filename
+	@return  True if the whole file was written. */
+	bool save(const std::string& filename) const;
+
+	/** replace the tables with ones written by save for graph
+	@return  False, leaving the tables as they were, if the file cannot
+	be read, was saved with other weight or id types or for a snapshot
+	with other vertices, edges or weights. */
+	bool load(const std::string& filename, const Snapshot& graph);
+
+	/** return number of landmarks */
+	unsigned getNumLandmarks() const;
+
+	/** return the vertex id of landmark i */
+	VertexId getLandmark(unsigned i) const;
+
+	/** return a lower bound on the cost from vertex from to vertex to
+	UNREACHABLE if a landmark shows to cannot be reached from from */
+	Cost lowerBound(VertexId from, VertexId to) const;
+
+	/** lowest cost from source to target, UNREACHABLE if unreachable
+	CsrGraph::aStarPath guided by lowerBound, graph must be the
+	snapshot the tables were built for
+	path is filled with the vertices from source to target */
+	Cost shortestPath(const Snapshot& graph, VertexId source,
+		VertexId target, std::vector<VertexId>& path) const;
+
+	/** shortestPath keeping its state in workspace */
+	Cost shortestPath(const Snapshot& graph, VertexId source,
+		VertexId target, std::vector<VertexId>& path,
+		Workspace& workspace) const;
+
+private:
+	/** vertices of the snapshot the tables are for */
+	uint32_t numVertices{ 0 };
+
+	/** hash of the edges and weights of that snapshot */
+	uint64_t fingerprint{ 0 };
+
+	/** vertex id of every landmark */
+	std::vector<VertexId> landmarks;
+
+	/** fromLandmark[v * landmarks + i] is the cost from landmark i to v,
+	the costs of one vertex are next to each other */
+	std::vector<Cost> fromLandmark;
+
+	/** toLandmark[v * landmarks + i] is the cost from v to landmark i */
+	std::vector<Cost> toLandmark;
+};  // end BasicLandmarks
+
+/** landmarks of the default CsrGraph */
+typedef BasicLandmarks<int, uint32_t> Landmarks;
+
+#endif  // LANDMARKS_H
@@ -0,0 +1,107 @@
+/**
+* Read-only view of a whole file in memory
+* On POSIX systems the file is memory-mapped, so opening costs almost
+* nothing and pages are read in by the OS as they are touched.
+* Elsewhere the file is read into a buffer once.
+*/
+
+#include <fstream>
+#include <string>
+
+#include "mappedfile.h"
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+// This is 80 characters - Keep all lines under 80 characters                 //
+////////////////////////////////////////////////////////////////////////////////
+
+/** constructor, nothing mapped */
+MappedFile::MappedFile()
+{
+}
+
+/** destructor, unmaps the file */
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+/** map the file, replacing any file mapped before
+sequential tells the OS the file will be read front to back
+@return  True if the file could be opened and mapped. */
+bool MappedFile::open(const std::string& filename, bool sequential)
+{
+	close();
+
+#if !defined(_WIN32)
+	int fd = ::open(filename.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+
+	struct stat info;
+	if (fstat(fd, &info) != 0) {
+		::close(fd);
+		return false;
+	}
+
+	// mmap cannot map zero bytes, an empty file is simply empty
+	length = static_cast<size_t>(info.st_size);
+	if (length == 0) {
+		::close(fd);
+		bytes = "";
+		return true;
+	}
+
+	void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (mapping == MAP_FAILED) {
+		length = 0;
+		return false;
+	}
+
+	// let the OS read ahead
+	if (sequential) {
+		madvise(mapping, length, MADV_SEQUENTIAL);
+	}
+	bytes = static_cast<const char*>(mapping);
+	return true;
+#else
+	std::ifstream fin(filename, std::ios::binary | std::ios::ate);
+	if (!fin) {
+		return false;
+	}
+
+	length = static_cast<size_t>(fin.tellg());
+	char* buffer = new char[length + 1];
+	fin.seekg(0);
+	fin.read(buffer, static_cast<std::streamsize>(length));
+	buffer[length] = '\0';
+	bytes = buffer;
+	buffered = true;
+	return true;
+#endif
+}
+
+/** unmap the file */
+void MappedFile::close()
+{
+	if (buffered) {
+		delete[] bytes;
+	}
+#if !defined(_WIN32)
+	else if (length > 0) {
+		munmap(const_cast<char*>(bytes), length);
+	}
+#endif
+
+	bytes = nullptr;
+	length = 0;
+	buffered = false;
+}
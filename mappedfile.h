@@ -0,0 +1,50 @@
+/**
+* Read-only view of a whole file in memory
+* On POSIX systems the file is memory-mapped, so opening costs almost
+* nothing and pages are read in by the OS as they are touched.
+* Elsewhere the file is read into a buffer once.
+*/
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+class MappedFile {
+public:
+	/** constructor, nothing mapped */
+	MappedFile();
+
+	/** destructor, unmaps the file */
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	/** map the file, replacing any file mapped before
+	sequential tells the OS the file will be read front to back
+	@return  True if the file could be opened and mapped. */
+	bool open(const std::string& filename, bool sequential = true);
+
+	/** unmap the file */
+	void close();
+
+	/** first byte of the file, nullptr if nothing is mapped */
+	const char* data() const { return bytes; }
+
+	/** number of bytes in the file */
+	size_t size() const { return length; }
+
+private:
+	/** start of the mapping or buffer */
+	const char* bytes{ nullptr };
+
+	/** length of the file */
+	size_t length{ 0 };
+
+	/** true if bytes was allocated instead of mapped */
+	bool buffered{ false };
+};  // end MappedFile
+
+#endif  // MAPPEDFILE_H
@@ -0,0 +1,142 @@
+/**
+* Thread pool that answers batches of queries on a read-only CsrGraph
+* Threads take BATCH_STEP queries at a time from a shared counter, so
+* long and short queries even out across the threads.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "querypool.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// This is 80 characters - Keep all lines under 80 characters                 //
+////////////////////////////////////////////////////////////////////////////////
+
+/** constructor, threads in total including the caller of run
+0 uses every core */
+template <typename Weight, typename VertexId>
+BasicQueryPool<Weight, VertexId>::BasicQueryPool(unsigned threads)
+{
+	if (threads == 0) {
+		threads = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	workspaces.resize(threads);
+	for (unsigned worker = 1; worker < threads; ++worker) {
+		workers.emplace_back(&BasicQueryPool::work, this, worker);
+	}
+}
+
+/** destructor, stops the worker threads */
+template <typename Weight, typename VertexId>
+BasicQueryPool<Weight, VertexId>::~BasicQueryPool()
+{
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		stopping = true;
+	}
+	wake.notify_all();
+
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+}
+
+/** return number of threads answering queries */
+template <typename Weight, typename VertexId>
+unsigned BasicQueryPool<Weight, VertexId>::getNumThreads() const
+{
+	return static_cast<unsigned>(workspaces.size());
+}
+
+/** answer every query in queries, spread over the threads */
+template <typename Weight, typename VertexId>
+void BasicQueryPool<Weight, VertexId>::run(const Snapshot& graph,
+	std::vector<Query>& queries)
+{
+	std::lock_guard<std::mutex> single(runLock);
+
+	{
+		std::lock_guard<std::mutex> guard(lock);
+		this->graph = &graph;
+		batch = queries.data();
+		batchSize = queries.size();
+		next = 0;
+		busy = static_cast<unsigned>(workers.size());
+		generation++;
+	}
+	wake.notify_all();
+
+	answer(0);
+
+	std::unique_lock<std::mutex> guard(lock);
+	finished.wait(guard, [this] { return busy == 0; });
+	batch = nullptr;
+	this->graph = nullptr;
+}
+
+/** body of worker thread number worker */
+template <typename Weight, typename VertexId>
+void BasicQueryPool<Weight, VertexId>::work(unsigned worker)
+{
+	uint64_t seen = 0;
+	for (;;) {
+		{
+			std::unique_lock<std::mutex> guard(lock);
+			wake.wait(guard, [&] {
+				return stopping || generation != seen;
+			});
+			if (stopping) {
+				return;
+			}
+			seen = generation;
+		}
+
+		answer(worker);
+
+		std::lock_guard<std::mutex> guard(lock);
+		if (--busy == 0) {
+			finished.notify_one();
+		}
+	}
+}
+
+/** answer queries from the current batch until none are left */
+template <typename Weight, typename VertexId>
+void BasicQueryPool<Weight, VertexId>::answer(unsigned worker)
+{
+	Workspace& workspace = workspaces[worker];
+	std::vector<VertexId> path;
+
+	for (;;) {
+		size_t first = next.fetch_add(BATCH_STEP);
+		if (first >= batchSize) {
+			return;
+		}
+
+		size_t last = std::min(batchSize, first + BATCH_STEP);
+		for (size_t i = first; i < last; ++i) {
+			Query& query = batch[i];
+			if (query.kind == Query::SHORTEST_PATH) {
+				query.cost = graph->bidirectionalShortestPath(query.source,
+					query.target, path, workspace);
+				query.reachable = query.cost != Snapshot::UNREACHABLE;
+			}
+			else {
+				query.reachable = graph->isReachable(query.source,
+					query.target, workspace);
+			}
+		}
+	}
+}
+
+// the weight and id types listed in graph.cpp
+template class BasicQueryPool<int, uint32_t>;
+template class BasicQueryPool<uint16_t, uint16_t>;
+template class BasicQueryPool<uint32_t, uint32_t>;
+template class BasicQueryPool<int64_t, uint32_t>;
+template class BasicQueryPool<float, uint32_t>;
@@ -0,0 +1,122 @@
+/**
+* Thread pool that answers batches of queries on a read-only CsrGraph
+* The worker threads are started once and wait between batches. Each
+* worker keeps its own SearchWorkspace, so after the first few queries
+* nothing is allocated or cleared per query. The thread calling run
+* works on the batch too.
+*/
+
+#ifndef QUERYPOOL_H
+#define QUERYPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "csrgraph.h"
+#include "searchworkspace.h"
+
+/** one query of a batch, run fills in the answer
+Weight and VertexId are those of the graph, see csrgraph.h */
+template <typename Weight, typename VertexId>
+struct BasicQuery {
+	/** what to find out about source and target */
+	enum Kind { SHORTEST_PATH, REACHABLE };
+
+	Kind kind;
+	VertexId source;
+	VertexId target;
+
+	/** lowest cost from source to target, CsrGraph::UNREACHABLE if
+	unreachable, only filled in for SHORTEST_PATH */
+	typename BasicCsrGraph<Weight, VertexId>::Cost cost;
+
+	/** True if target can be reached from source */
+	bool reachable;
+};
+
+/** Weight and VertexId are those of the graph, see csrgraph.h */
+template <typename Weight, typename VertexId>
+class BasicQueryPool {
+public:
+	/** graph the queries are answered on */
+	typedef BasicCsrGraph<Weight, VertexId> Snapshot;
+
+	/** what a batch is made of */
+	typedef BasicQuery<Weight, VertexId> Query;
+
+	/** per-query state of one thread */
+	typedef typename Snapshot::Workspace Workspace;
+
+	/** constructor, threads in total including the caller of run
+	0 uses every core */
+	explicit BasicQueryPool(unsigned threads = 0);
+
+	/** destructor, stops the worker threads */
+	~BasicQueryPool();
+
+	BasicQueryPool(const BasicQueryPool&) = delete;
+	BasicQueryPool& operator=(const BasicQueryPool&) = delete;
+
+	/** return number of threads answering queries */
+	unsigned getNumThreads() const;
+
+	/** answer every query in queries, spread over the threads
+	returns once all of them are answered. Batches from different
+	callers are run one after the other. */
+	void run(const Snapshot& graph, std::vector<Query>& queries);
+
+private:
+	/** queries a thread takes at a time */
+	static constexpr size_t BATCH_STEP = 16;
+
+	/** body of worker thread number worker */
+	void work(unsigned worker);
+
+	/** answer queries from the current batch until none are left */
+	void answer(unsigned worker);
+
+	/** worker threads, the caller of run is worker 0 */
+	std::vector<std::thread> workers;
+
+	/** one workspace per thread, index 0 belongs to the caller */
+	std::vector<Workspace> workspaces;
+
+	/** only one batch runs at a time */
+	std::mutex runLock;
+
+	/** guards everything below */
+	std::mutex lock;
+
+	/** wakes the workers when a batch starts or the pool stops */
+	std::condition_variable wake;
+
+	/** wakes run when the last worker has finished */
+	std::condition_variable finished;
+
+	/** the batch being answered */
+	const Snapshot* graph{ nullptr };
+	Query* batch{ nullptr };
+	size_t batchSize{ 0 };
+
+	/** index of the next query nobody has taken yet */
+	std::atomic<size_t> next{ 0 };
+
+	/** workers still answering the current batch */
+	unsigned busy{ 0 };
+
+	/** bumped for every batch, workers wait for it to change */
+	uint64_t generation{ 0 };
+
+	/** set by the destructor */
+	bool stopping{ false };
+};  // end BasicQueryPool
+
+/** query and pool of the default CsrGraph */
+typedef BasicQuery<int, uint32_t> Query;
+typedef BasicQueryPool<int, uint32_t> QueryPool;
+
+#endif  // QUERYPOOL_H
@@ -0,0 +1,151 @@
+/**
+* Counters of one search, to see where a slow query spends its time
+* Searches record into the SearchStats of the workspace they run in:
+* vertices settled, edges scanned, heap pushes and pops, stale heap
+* entries, the largest frontier and the time spent in each phase.
+* The counters are only kept when GRAPH_STATS is defined. Otherwise
+* SearchStats is NoSearchStats, whose functions are empty and inline, so
+* the calls in the searches compile to nothing and every count reads 0.
+* GRAPH_STATS must be defined, or not, for the whole build.
+* Recorded by depthFirstTraversal, breadthFirstTraversal,
+* shortestPathTree, shortestPath, aStarPath and djikstraCostToAllVertices.
+*/
+
+#ifndef SEARCHSTATS_H
+#define SEARCHSTATS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/** parts of a search that are timed separately
+SETUP clears the state of the last search, SEARCH explores the graph
+and OUTPUT copies the result out, such as a path or the label maps */
+enum class SearchPhase { SETUP, SEARCH, OUTPUT };
+
+/** counters and phase times of the last search */
+class CountingSearchStats {
+public:
+	/** True, the counters are kept */
+	static constexpr bool ENABLED = true;
+
+	/** zero every counter and start timing SETUP */
+	void clear()
+	{
+		*this = CountingSearchStats();
+		phase(SearchPhase::SETUP);
+	}
+
+	/** a vertex was visited, or settled by a shortest-path search */
+	void settle() { ++settled; }
+
+	/** edges were looked at */
+	void scan(uint64_t edges) { scanned += edges; }
+
+	/** an entry was added to a heap that now holds size entries */
+	void push(size_t size)
+	{
+		++pushes;
+		frontier(size);
+	}
+
+	/** an entry was taken off a heap */
+	void pop() { ++pops; }
+
+	/** a popped heap entry was stale, its vertex was already settled
+	at a lower cost */
+	void stale() { ++staleEntries; }
+
+	/** the frontier, stack, level or heap, holds size entries */
+	void frontier(size_t size)
+	{
+		maxFrontier = std::max<uint64_t>(maxFrontier, size);
+	}
+
+	/** charge the time since the last call to the running phase, then
+	time next, also restarts timing after stop */
+	void phase(SearchPhase next)
+	{
+		Clock::time_point now = Clock::now();
+		if (running) {
+			seconds[static_cast<int>(current)] +=
+				std::chrono::duration<double>(now - since).count();
+		}
+		current = next;
+		since = now;
+		running = true;
+	}
+
+	/** charge the time since the last call to the running phase and
+	stop timing */
+	void stop()
+	{
+		phase(current);
+		running = false;
+	}
+
+	uint64_t getSettled() const { return settled; }
+	uint64_t getScanned() const { return scanned; }
+	uint64_t getPushes() const { return pushes; }
+	uint64_t getPops() const { return pops; }
+	uint64_t getStale() const { return staleEntries; }
+	uint64_t getMaxFrontier() const { return maxFrontier; }
+
+	/** seconds spent in the given phase */
+	double getSeconds(SearchPhase which) const
+	{
+		return seconds[static_cast<int>(which)];
+	}
+
+private:
+	typedef std::chrono::steady_clock Clock;
+
+	uint64_t settled{ 0 };
+	uint64_t scanned{ 0 };
+	uint64_t pushes{ 0 };
+	uint64_t pops{ 0 };
+	uint64_t staleEntries{ 0 };
+	uint64_t maxFrontier{ 0 };
+
+	/** seconds by SearchPhase */
+	double seconds[3]{ 0, 0, 0 };
+
+	/** phase being timed and when it started */
+	SearchPhase current{ SearchPhase::SETUP };
+	Clock::time_point since;
+	bool running{ false };
+};  // end CountingSearchStats
+
+/** same functions as CountingSearchStats, none of them do anything */
+class NoSearchStats {
+public:
+	/** False, nothing is counted */
+	static constexpr bool ENABLED = false;
+
+	void clear() {}
+	void settle() {}
+	void scan(uint64_t) {}
+	void push(size_t) {}
+	void pop() {}
+	void stale() {}
+	void frontier(size_t) {}
+	void phase(SearchPhase) {}
+	void stop() {}
+
+	uint64_t getSettled() const { return 0; }
+	uint64_t getScanned() const { return 0; }
+	uint64_t getPushes() const { return 0; }
+	uint64_t getPops() const { return 0; }
+	uint64_t getStale() const { return 0; }
+	uint64_t getMaxFrontier() const { return 0; }
+	double getSeconds(SearchPhase) const { return 0; }
+};  // end NoSearchStats
+
+#ifdef GRAPH_STATS
+typedef CountingSearchStats SearchStats;
+#else
+typedef NoSearchStats SearchStats;
+#endif
+
+#endif  // SEARCHSTATS_H
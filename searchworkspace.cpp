@@ -0,0 +1,40 @@
+/**
+* Per-query state for graph searches
+* Every vertex entry is stamped with the query that wrote it. Starting a
+* new query only bumps the stamp.
+*/
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "searchworkspace.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// This is 80 characters - Keep all lines under 80 characters                 //
+////////////////////////////////////////////////////////////////////////////////
+
+/** forget every vertex, make room for numVertices vertices */
+template <typename Cost, typename VertexId>
+void BasicVertexMarks<Cost, VertexId>::reset(uint32_t numVertices)
+{
+	if (stamps.size() < numVertices) {
+		stamps.resize(numVertices, 0);
+		costs.resize(numVertices);
+		parents.resize(numVertices);
+	}
+
+	// after 4 billion searches the stamps wrap around, old stamps
+	// could match again so they are cleared once
+	if (++epoch == 0) {
+		std::fill(stamps.begin(), stamps.end(), 0);
+		epoch = 1;
+	}
+}
+
+// the cost and id types of the graphs instantiated in graph.cpp
+template class BasicVertexMarks<int, uint32_t>;
+template class BasicVertexMarks<uint32_t, uint16_t>;
+template class BasicVertexMarks<uint64_t, uint32_t>;
+template class BasicVertexMarks<int64_t, uint32_t>;
+template class BasicVertexMarks<float, uint32_t>;
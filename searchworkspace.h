@@ -0,0 +1,129 @@
+/**
+* Per-query state for graph searches
+* Traversals and shortest-path queries keep what they have reached here
+* instead of in the graph, so the graph stays const and several queries
+* can run at the same time, each with its own workspace.
+* Every vertex entry is stamped with the query that wrote it. Starting a
+* new query only bumps the stamp, so a workspace that is reused does not
+* have to be cleared and small queries on big graphs cost only what they
+* touch.
+* The workspace also holds the SearchStats of the last search run in it,
+* see searchstats.h.
+*/
+
+#ifndef SEARCHWORKSPACE_H
+#define SEARCHWORKSPACE_H
+
+#include <climits>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "searchstats.h"
+
+/** cost and parent of each vertex reached by one search
+Cost is what path costs are added up in, VertexId the vertex ids of
+the graph searched */
+template <typename Cost, typename VertexId>
+class BasicVertexMarks {
+public:
+	/** parent of vertices with no parent, same as CsrGraph::NO_VERTEX */
+	static constexpr VertexId NO_VERTEX =
+		std::numeric_limits<VertexId>::max();
+
+	/** cost of vertices not reached, same as CsrGraph::UNREACHABLE */
+	static constexpr Cost UNREACHABLE =
+		std::numeric_limits<Cost>::has_infinity ?
+		std::numeric_limits<Cost>::infinity() :
+		std::numeric_limits<Cost>::max();
+
+	/** forget every vertex, make room for numVertices vertices */
+	void reset(uint32_t numVertices);
+
+	/** True if the vertex was reached since the last reset */
+	bool isReached(VertexId v) const { return stamps[v] == epoch; }
+
+	/** mark the vertex reached, without a cost */
+	void reach(VertexId v) { stamps[v] = epoch; }
+
+	/** lowest cost found to v, UNREACHABLE if not reached */
+	Cost getCost(VertexId v) const
+	{
+		return isReached(v) ? costs[v] : UNREACHABLE;
+	}
+
+	/** vertex before v on the cheapest path, NO_VERTEX if none */
+	VertexId getParent(VertexId v) const
+	{
+		return isReached(v) ? parents[v] : NO_VERTEX;
+	}
+
+	/** mark v reached with the given cost and parent */
+	void setCost(VertexId v, Cost cost, VertexId parent)
+	{
+		stamps[v] = epoch;
+		costs[v] = cost;
+		parents[v] = parent;
+	}
+
+private:
+	/** stamps[v] == epoch if v was reached by the current search */
+	std::vector<uint32_t> stamps;
+
+	/** only meaningful for reached vertices */
+	std::vector<Cost> costs;
+
+	/** only meaningful for reached vertices */
+	std::vector<VertexId> parents;
+
+	/** stamp of the current search, 0 is never used */
+	uint32_t epoch{ 0 };
+};  // end BasicVertexMarks
+
+/** everything a search needs, reused from one query to the next
+the vectors keep their capacity so a warm workspace does not allocate */
+template <typename Cost, typename VertexId>
+struct BasicSearchWorkspace {
+	/** (cost, vertex) entries of a binary heap */
+	typedef std::pair<Cost, VertexId> HeapEntry;
+
+	/** the search from the start vertex */
+	BasicVertexMarks<Cost, VertexId> forward;
+
+	/** the search back from the target vertex */
+	BasicVertexMarks<Cost, VertexId> backward;
+
+	/** vertex and next edge to look at, for depth-first traversal */
+	std::vector<std::pair<VertexId, uint32_t>> stack;
+
+	/** vertices in the order breadth-first traversal reaches them */
+	std::vector<VertexId> queue;
+
+	/** vertices of the next level of a level-synchronous search */
+	std::vector<VertexId> nextQueue;
+
+	/** vertices 0-1 BFS reaches over zero-weight edges, a heap */
+	std::vector<VertexId> sameLevel;
+
+	/** one bit per vertex, set for the vertices of the current level
+	when it is expanded bottom-up */
+	std::vector<uint64_t> levelBits;
+
+	/** heaps for the forward and backward searches */
+	std::vector<HeapEntry> heap[2];
+
+	/** buckets of the bucket queue used for small integer weights,
+	bucket i holds the vertices whose cost is i modulo their number */
+	std::vector<std::vector<VertexId>> buckets;
+
+	/** counters of the last search, empty unless GRAPH_STATS is
+	defined */
+	SearchStats stats;
+};  // end BasicSearchWorkspace
+
+/** marks and workspace of the default Graph */
+typedef BasicVertexMarks<int, uint32_t> VertexMarks;
+typedef BasicSearchWorkspace<int, uint32_t> SearchWorkspace;
+
+#endif  // SEARCHWORKSPACE_H
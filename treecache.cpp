@@ -0,0 +1,254 @@
+/**
+* Cache of shortest-path trees by source vertex
+* The cache is a list of trees from most to least recently used and a
+* hash map from source to list position, so find, insert and eviction
+* each take constant time.
+*/
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "treecache.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// This is 80 characters - Keep all lines under 80 characters                 //
+////////////////////////////////////////////////////////////////////////////////
+
+/** constructor, search graph from source */
+template <typename Weight, typename VertexId>
+BasicShortestPathTree<Weight, VertexId>::BasicShortestPathTree(
+	const Snapshot& graph, VertexId source, Workspace& workspace)
+	: graph(graph), source(source)
+{
+	graph.shortestPathTree(source, cost, parent, workspace);
+}
+
+/** return the snapshot the tree was found on */
+template <typename Weight, typename VertexId>
+const typename BasicShortestPathTree<Weight, VertexId>::Snapshot&
+BasicShortestPathTree<Weight, VertexId>::getSnapshot() const
+{
+	return graph;
+}
+
+/** return the vertex the tree was grown from */
+template <typename Weight, typename VertexId>
+VertexId BasicShortestPathTree<Weight, VertexId>::getSource() const
+{
+	return source;
+}
+
+/** return the lowest cost from the source to every vertex by id */
+template <typename Weight, typename VertexId>
+const std::vector<typename BasicShortestPathTree<Weight, VertexId>::Cost>&
+BasicShortestPathTree<Weight, VertexId>::getCosts() const
+{
+	return cost;
+}
+
+/** return the vertex before every vertex on its cheapest path by id */
+template <typename Weight, typename VertexId>
+const std::vector<VertexId>&
+BasicShortestPathTree<Weight, VertexId>::getParents() const
+{
+	return parent;
+}
+
+/** return the lowest cost from the source to the labelled vertex */
+template <typename Weight, typename VertexId>
+typename BasicShortestPathTree<Weight, VertexId>::Cost
+BasicShortestPathTree<Weight, VertexId>::getCost(
+	std::string_view vertexLabel) const
+{
+	VertexId v = graph.findVertex(vertexLabel);
+	return v == NO_VERTEX ? UNREACHABLE : cost[v];
+}
+
+/** return the label of the vertex before the labelled vertex */
+template <typename Weight, typename VertexId>
+std::string_view BasicShortestPathTree<Weight, VertexId>::getPrevious(
+	std::string_view vertexLabel) const
+{
+	VertexId v = graph.findVertex(vertexLabel);
+	if (v == NO_VERTEX || parent[v] == NO_VERTEX) {
+		return std::string_view();
+	}
+	return graph.getLabel(parent[v]);
+}
+
+/** copy the tree into the maps of djikstraCostToAllVertices */
+template <typename Weight, typename VertexId>
+void BasicShortestPathTree<Weight, VertexId>::toMaps(
+	std::map<std::string, Cost>& weight,
+	std::map<std::string, std::string>& previous) const
+{
+	weight.clear();
+	previous.clear();
+	graph.treeToMaps(cost, parent, weight, previous);
+}
+
+/** return bytes of the cost and parent arrays */
+template <typename Weight, typename VertexId>
+size_t BasicShortestPathTree<Weight, VertexId>::getBytes() const
+{
+	return cost.size() * sizeof(Cost) + parent.size() * sizeof(VertexId);
+}
+
+/** constructor, cache of up to budget bytes of trees */
+template <typename Weight, typename VertexId>
+BasicTreeCache<Weight, VertexId>::BasicTreeCache(size_t budget)
+	: budget(budget)
+{
+}
+
+/** change the budget, dropping trees until the rest fit, they are
+not counted as evictions */
+template <typename Weight, typename VertexId>
+void BasicTreeCache<Weight, VertexId>::setBudget(size_t budget)
+{
+	std::lock_guard<std::mutex> guard(lock);
+	this->budget = budget;
+	while (bytes > budget) {
+		dropOldest();
+	}
+}
+
+/** return the budget in bytes */
+template <typename Weight, typename VertexId>
+size_t BasicTreeCache<Weight, VertexId>::getBudget() const
+{
+	std::lock_guard<std::mutex> guard(lock);
+	return budget;
+}
+
+/** return the tree grown from source and mark it most recently used */
+template <typename Weight, typename VertexId>
+std::shared_ptr<const typename BasicTreeCache<Weight, VertexId>::Tree>
+BasicTreeCache<Weight, VertexId>::find(VertexId source)
+{
+	std::lock_guard<std::mutex> guard(lock);
+	if (budget == 0) {
+		return nullptr;
+	}
+
+	auto found = bySource.find(source);
+	if (found == bySource.end()) {
+		++misses;
+		return nullptr;
+	}
+	++hits;
+	recency.splice(recency.begin(), recency, found->second);
+	return *found->second;
+}
+
+/** keep tree as the most recently used */
+template <typename Weight, typename VertexId>
+void BasicTreeCache<Weight, VertexId>::insert(
+	const std::shared_ptr<const Tree>& tree)
+{
+	std::lock_guard<std::mutex> guard(lock);
+	size_t size = tree->getBytes();
+	if (size > budget) {
+		return;
+	}
+
+	// another thread may have found the same tree in the meantime
+	auto found = bySource.find(tree->getSource());
+	if (found != bySource.end()) {
+		recency.splice(recency.begin(), recency, found->second);
+		return;
+	}
+	makeRoom(size);
+	recency.push_front(tree);
+	bySource.emplace(tree->getSource(), recency.begin());
+	bytes += size;
+}
+
+/** drop every tree */
+template <typename Weight, typename VertexId>
+void BasicTreeCache<Weight, VertexId>::clear()
+{
+	std::lock_guard<std::mutex> guard(lock);
+	recency.clear();
+	bySource.clear();
+	bytes = 0;
+}
+
+/** return number of trees held */
+template <typename Weight, typename VertexId>
+size_t BasicTreeCache<Weight, VertexId>::getNumTrees() const
+{
+	std::lock_guard<std::mutex> guard(lock);
+	return recency.size();
+}
+
+/** return bytes of the trees held */
+template <typename Weight, typename VertexId>
+size_t BasicTreeCache<Weight, VertexId>::getBytes() const
+{
+	std::lock_guard<std::mutex> guard(lock);
+	return bytes;
+}
+
+/** return number of finds that returned a tree */
+template <typename Weight, typename VertexId>
+uint64_t BasicTreeCache<Weight, VertexId>::getHits() const
+{
+	std::lock_guard<std::mutex> guard(lock);
+	return hits;
+}
+
+/** return number of finds that returned nullptr */
+template <typename Weight, typename VertexId>
+uint64_t BasicTreeCache<Weight, VertexId>::getMisses() const
+{
+	std::lock_guard<std::mutex> guard(lock);
+	return misses;
+}
+
+/** return number of trees dropped to make room */
+template <typename Weight, typename VertexId>
+uint64_t BasicTreeCache<Weight, VertexId>::getEvictions() const
+{
+	std::lock_guard<std::mutex> guard(lock);
+	return evictions;
+}
+
+/** drop the least recently used trees until bytes more fit, the lock
+is held by the caller */
+template <typename Weight, typename VertexId>
+void BasicTreeCache<Weight, VertexId>::makeRoom(size_t bytes)
+{
+	while (!recency.empty() && this->bytes + bytes > budget) {
+		dropOldest();
+		++evictions;
+	}
+}
+
+/** drop the least recently used tree, the lock is held by the caller */
+template <typename Weight, typename VertexId>
+void BasicTreeCache<Weight, VertexId>::dropOldest()
+{
+	bytes -= recency.back()->getBytes();
+	bySource.erase(recency.back()->getSource());
+	recency.pop_back();
+}
+
+// the weight and id types listed in graph.cpp
+template class BasicShortestPathTree<int, uint32_t>;
+template class BasicShortestPathTree<uint16_t, uint16_t>;
+template class BasicShortestPathTree<uint32_t, uint32_t>;
+template class BasicShortestPathTree<int64_t, uint32_t>;
+template class BasicShortestPathTree<float, uint32_t>;
+
+template class BasicTreeCache<int, uint32_t>;
+template class BasicTreeCache<uint16_t, uint16_t>;
+template class BasicTreeCache<uint32_t, uint32_t>;
+template class BasicTreeCache<int64_t, uint32_t>;
+template class BasicTreeCache<float, uint32_t>;
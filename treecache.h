@@ -0,0 +1,176 @@
+/**
+* Cache of shortest-path trees by source vertex
+* A ShortestPathTree holds the cost and parent of every vertex found by
+* one CsrGraph::shortestPathTree search. It never changes once built,
+* so a tree from the cache is handed out as a shared pointer and read
+* in place instead of being copied into the caller's maps.
+* TreeCache keeps the trees used most recently, up to a budget of
+* bytes, and drops the least recently used one when a new tree does
+* not fit. Graph owns one, off until it is given a budget, and clears
+* it whenever the graph changes. A tree the caller still holds stays
+* valid after it leaves the cache: it keeps a copy of the snapshot it
+* was found on, which shares the arrays of that snapshot.
+* Any number of threads may use one cache at the same time.
+*/
+
+#ifndef TREECACHE_H
+#define TREECACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "csrgraph.h"
+#include "weighttraits.h"
+
+/** Weight and VertexId are those of the snapshot, see csrgraph.h */
+template <typename Weight, typename VertexId>
+class BasicShortestPathTree {
+public:
+	/** snapshot the tree was found on */
+	typedef BasicCsrGraph<Weight, VertexId> Snapshot;
+
+	/** type path costs are added up in */
+	typedef typename WeightTraits<Weight>::Cost Cost;
+
+	/** per-query state for the search that builds the tree */
+	typedef typename Snapshot::Workspace Workspace;
+
+	/** cost of a vertex that cannot be reached */
+	static constexpr Cost UNREACHABLE = WeightTraits<Weight>::UNREACHABLE;
+
+	/** parent of the source and of vertices that cannot be reached */
+	static constexpr VertexId NO_VERTEX = Snapshot::NO_VERTEX;
+
+	/** constructor, search graph from source keeping the search state
+	in workspace, source must be a vertex of graph */
+	BasicShortestPathTree(const Snapshot& graph, VertexId source,
+		Workspace& workspace);
+
+	/** return the snapshot the tree was found on */
+	const Snapshot& getSnapshot() const;
+
+	/** return the vertex the tree was grown from */
+	VertexId getSource() const;
+
+	/** return the lowest cost from the source to every vertex by id,
+	UNREACHABLE for vertices that cannot be reached */
+	const std::vector<Cost>& getCosts() const;
+
+	/** return the vertex before every vertex on its cheapest path by
+	id, NO_VERTEX for the source and vertices that cannot be reached */
+	const std::vector<VertexId>& getParents() const;
+
+	/** return the lowest cost from the source to the vertex with the
+	given label, UNREACHABLE if it does not exist or cannot be
+	reached */
+	Cost getCost(std::string_view vertexLabel) const;
+
+	/** return the label of the vertex before the vertex with the given
+	label on its cheapest path, empty for the source and for vertices
+	that do not exist or cannot be reached */
+	std::string_view getPrevious(std::string_view vertexLabel) const;
+
+	/** copy the tree into the maps Graph::djikstraCostToAllVertices
+	fills, replacing what they held */
+	void toMaps(std::map<std::string, Cost>& weight,
+		std::map<std::string, std::string>& previous) const;
+
+	/** return bytes of the cost and parent arrays */
+	size_t getBytes() const;
+
+private:
+	Snapshot graph;
+	VertexId source;
+	std::vector<Cost> cost;
+	std::vector<VertexId> parent;
+};  // end BasicShortestPathTree
+
+/** Weight and VertexId are those of the snapshot, see csrgraph.h */
+template <typename Weight, typename VertexId>
+class BasicTreeCache {
+public:
+	/** what the cache holds */
+	typedef BasicShortestPathTree<Weight, VertexId> Tree;
+
+	/** constructor, cache of up to budget bytes of trees, 0 is off */
+	explicit BasicTreeCache(size_t budget = 0);
+
+	BasicTreeCache(const BasicTreeCache&) = delete;
+	BasicTreeCache& operator=(const BasicTreeCache&) = delete;
+
+	/** change the budget, dropping the least recently used trees until
+	the rest fit, 0 empties the cache and turns it off. Trees dropped
+	here are not counted as evictions. */
+	void setBudget(size_t budget);
+
+	/** return the budget in bytes, 0 if the cache is off */
+	size_t getBudget() const;
+
+	/** return the tree grown from source and mark it most recently used
+	returns nullptr, counted as a miss, if it is not cached. Nothing
+	is counted while the cache is off. */
+	std::shared_ptr<const Tree> find(VertexId source);
+
+	/** keep tree as the most recently used, dropping the least recently
+	used trees while it does not fit. A tree bigger than the whole
+	budget is not kept. */
+	void insert(const std::shared_ptr<const Tree>& tree);
+
+	/** drop every tree, their sources no longer mean the same vertices
+	or the graph changed, the counters are kept */
+	void clear();
+
+	/** return number of trees held */
+	size_t getNumTrees() const;
+
+	/** return bytes of the trees held, see ShortestPathTree::getBytes */
+	size_t getBytes() const;
+
+	/** return number of finds that returned a tree */
+	uint64_t getHits() const;
+
+	/** return number of finds that returned nullptr */
+	uint64_t getMisses() const;
+
+	/** return number of trees dropped to make room for new ones, a
+	sign the budget is too small */
+	uint64_t getEvictions() const;
+
+private:
+	/** trees from most to least recently used */
+	typedef std::list<std::shared_ptr<const Tree>> Recency;
+
+	/** drop the least recently used trees until bytes more fit */
+	void makeRoom(size_t bytes);
+
+	/** drop the least recently used tree, there must be one */
+	void dropOldest();
+
+	/** guards everything below */
+	mutable std::mutex lock;
+
+	size_t budget;
+	size_t bytes{ 0 };
+	Recency recency;
+
+	/** position of every cached tree in recency by source */
+	std::unordered_map<VertexId, typename Recency::iterator> bySource;
+
+	uint64_t hits{ 0 };
+	uint64_t misses{ 0 };
+	uint64_t evictions{ 0 };
+};  // end BasicTreeCache
+
+/** tree and cache of the default CsrGraph */
+typedef BasicShortestPathTree<int, uint32_t> ShortestPathTree;
+typedef BasicTreeCache<int, uint32_t> TreeCache;
+
+#endif  // TREECACHE_H
@@ -3,8 +3,6 @@
 * Each vertex has a unique label
 * Can be connected to other vertices via weighted edges
 * Cannot be connected to itself
-* Used by depth-first search and breadth-first search
-* to keep track of if it has been visited or not
 */
 
 #include <climits>
@@ -15,150 +13,155 @@
 #include <string>
 #include <algorithm>
 
-#include "edge.h"
-
 
 ////////////////////////////////////////////////////////////////////////////////
 // This is 80 characters - Keep all lines under 80 characters                 //
 ////////////////////////////////////////////////////////////////////////////////
 
 
-/** Creates an unvisited vertex, gives it a label, and clears its
+/** Creates a vertex, gives it a label, and clears its
 adjacency list.
+The vertex keeps its own LabelPool for its label and the labels
+of its neighbors.
 NOTE: A vertex must have a unique label that cannot be changed. */
-Vertex::Vertex(std::string label)
+template <typename Weight>
+BasicVertex<Weight>::BasicVertex(std::string_view label,
+	std::pmr::memory_resource* memory)
+	: ownLabels(new LabelPool(memory)), labels(ownLabels.get()),
+	vertexLabel(labels->intern(label)),
+	adjacencyList(ByLabel{ labels }, memory)
 {
-	this->vertexLabel = label;
-
 }
 
-/** @return  The label of this vertex. */
-std::string Vertex::getLabel() const
+/** Creates a vertex with a label already in labels, which the
+vertex shares with the graph. */
+template <typename Weight>
+BasicVertex<Weight>::BasicVertex(LabelPool::Label label, LabelPool& labels,
+	std::pmr::memory_resource* memory)
+	: labels(&labels), vertexLabel(label),
+	adjacencyList(ByLabel{ &labels }, memory)
 {
-	return vertexLabel; 
 }
 
-/** Marks this vertex as visited. */
-void Vertex::visit()
+/** @return  The label of this vertex. */
+template <typename Weight>
+std::string BasicVertex<Weight>::getLabel() const
 {
-	visited = true;
+	return std::string(labels->view(vertexLabel)); 
 }
 
-/** Marks this vertex as not visited. */
-void Vertex::unvisit()
+/** @return  The handle of the label of this vertex. */
+template <typename Weight>
+LabelPool::Label BasicVertex<Weight>::getLabelId() const
 {
-	visited = false;
-}
-
-/** Returns the visited status of this vertex.
-@return  True if the vertex has been visited, otherwise
-returns false/ */
-bool Vertex::isVisited() const
-{ 
-	if (visited == true)
-		return true;
-	else
-		return false;
+	return vertexLabel;
 }
 
 /** Adds an edge between this vertex and the given vertex.
 Cannot have multiple connections to the same endVertex
 Cannot connect back to itself
 @return  True if the connection is successful. */
-bool Vertex::connect(const std::string& endVertex, const int edgeWeight)
+template <typename Weight>
+bool BasicVertex<Weight>::connect(std::string_view endVertex,
+	const Weight edgeWeight)
 { 
-	Edge temp(endVertex, edgeWeight);
-
-	adjacencyList.insert(std::pair<std::string, Edge>(endVertex, temp));
-	currentNeighbor = adjacencyList.find(endVertex);
+	return connect(labels->intern(endVertex), edgeWeight);
+}
 
+/** Adds an edge to the vertex whose label has handle endVertex
+@return  True if the connection is successful. */
+template <typename Weight>
+bool BasicVertex<Weight>::connect(LabelPool::Label endVertex,
+	const Weight edgeWeight)
+{
+	// an existing edge keeps its weight
+	adjacencyList.emplace(endVertex, edgeWeight);
 	return true;
-	
+}
+
+/** Adds an edge for each of first .. last - 1, in alphabetical order
+of their end vertex, moving the ones added to the front
+@return  The number of edges added. */
+template <typename Weight>
+size_t BasicVertex<Weight>::connectSorted(
+	typename std::vector<Connection>::iterator first,
+	typename std::vector<Connection>::iterator last)
+{
+	// the next end goes right after the one before, or later
+	typename AdjacencyList::iterator hint = adjacencyList.begin();
+	size_t added = 0;
+	for (typename std::vector<Connection>::iterator next = first;
+		next != last; ++next) {
+		size_t size = adjacencyList.size();
+		hint = adjacencyList.emplace_hint(hint, next->first, next->second);
+		++hint;
+		if (adjacencyList.size() > size) {
+			first[added++] = *next;
+		}
+	}
+	return added;
 }
 
 /** Removes the edge between this vertex and the given one.
 @return  True if the removal is successful. */
-bool Vertex::disconnect(const std::string& endVertex)
+template <typename Weight>
+bool BasicVertex<Weight>::disconnect(std::string_view endVertex)
 {
-	map<string, Edge>::iterator it;
-
-	for (it = adjacencyList.begin(); it != adjacencyList.end(); ++it) {
-		if (it->second.getEndVertex() == endVertex) {
-			adjacencyList.erase(it);
-			return true;
-		}
+	LabelPool::Label end = labels->find(endVertex);
+	if (end == LabelPool::NO_LABEL) {
+		return false;
 	}
-		
-	return false;
+
+	return adjacencyList.erase(end) == 1;
 }
 
 /** Gets the weight of the edge between this vertex and the given vertex.
 @return  The edge weight. This value is zero for an unweighted graph and
-is negative if the .edge does not exist */
-int Vertex::getEdgeWeight(const std::string& endVertex)
+is NO_EDGE if the .edge does not exist */
+template <typename Weight>
+Weight BasicVertex<Weight>::getEdgeWeight(std::string_view endVertex) const
 { 
-	map<string, Edge>::iterator it;
-
-	for (it = adjacencyList.begin(); it != adjacencyList.end(); ++it) {
-		if (it->second.getEndVertex() == endVertex) {
-			return it->second.getWeight();
-		}
+	LabelPool::Label end = labels->find(endVertex);
+	if (end == LabelPool::NO_LABEL) {
+		return NO_EDGE;
 	}
-	return -1;
-}
 
-/** Calculates how many neighbors this vertex has.
-@return  The number of the vertex's neighbors. */
-int Vertex::getNumberOfNeighbors(){
-	
-	map<string, Edge>::iterator it;
-	int neighborCount = 0;
-
-	for (it = adjacencyList.begin(); it != adjacencyList.end(); ++it) {
-		neighborCount++;
+	typename AdjacencyList::const_iterator it = adjacencyList.find(end);
+	if (it != adjacencyList.end()) {
+		return it->second;
 	}
-	 
-	return neighborCount;
+	return NO_EDGE;
 }
 
-/** Sets current neighbor to first in adjacency list. */
-void Vertex::resetNeighbor()
+/** @return  The number of the vertex's neighbors. */
+template <typename Weight>
+int BasicVertex<Weight>::getNumberOfNeighbors() const
 {
-	currentNeighbor = adjacencyList.begin();
+	return static_cast<int>(adjacencyList.size());
 }
 
-/** Gets this vertex's next neighbor in the adjacency list.
-Neighbors are automatically sorted alphabetically via map
-Returns the vertex label if there are no more neighbors
-@return  The label of the vertex's next neighbor. */
-std::string Vertex::getNextNeighbor() 
-{ 
-	map<string, Edge>::iterator it = adjacencyList.begin();
-	int count = 0;
-
-	if (adjacencyList.empty()) {
-		return vertexLabel;
-	}
-
-	while (count != this->getNumberOfNeighbors() - 1) {
-		it++;
-		count++;
-	}
-
-	if (it == currentNeighbor) {
-		return vertexLabel;
-	}
-	
-	currentNeighbor++;
-
-	return currentNeighbor->first;
+/** Neighbors are automatically sorted alphabetically via map
+@return  The neighbors of this vertex. */
+template <typename Weight>
+typename BasicVertex<Weight>::NeighborRange
+BasicVertex<Weight>::neighbors() const
+{
+	return NeighborRange(adjacencyList, labels);
 }
 
 /** Sees whether this vertex is equal to another one.
 Two vertices are equal if they have the same label. */
-bool Vertex::operator==(const Vertex& rightHandItem) const
+template <typename Weight>
+bool BasicVertex<Weight>::operator==(
+	const BasicVertex& rightHandItem) const
 {
-	if (this->getLabel() == rightHandItem.getLabel()) {
+	// vertices of one graph share a pool, one label has one handle
+	if (labels == rightHandItem.labels) {
+		return vertexLabel == rightHandItem.vertexLabel;
+	}
+
+	if (labels->view(vertexLabel) ==
+		rightHandItem.labels->view(rightHandItem.vertexLabel)) {
 		return true;
 	}
 
@@ -167,51 +170,21 @@ bool Vertex::operator==(const Vertex& rightHandItem) const
 
 /** Sees whether this vertex is < another one.
 Compares vertexLabel. */
-bool Vertex::operator<(const Vertex& rightHandItem) const
+template <typename Weight>
+bool BasicVertex<Weight>::operator<(
+	const BasicVertex& rightHandItem) const
 { 
-	if (this->getLabel() < rightHandItem.getLabel()) {
+	if (labels->view(vertexLabel) <
+		rightHandItem.labels->view(rightHandItem.vertexLabel)) {
 		return true;
 	}
 
 	return false;
 }
 
-/**Used to get the first neighbor of a vertex, get next neighbor increments
-currentNeighbor iterator so it can not be used to get the first neighbor*/
-string Vertex::getCurrentNeighbor()
-{
-	map<string, Edge>::iterator it = adjacencyList.begin();
-	int count = 0;
-
-	// for empty list
-	if (adjacencyList.empty()) {
-		return vertexLabel;
-	}
-
-	// sets an iterator to the last value in the adjacency list to ensure
-	// the currentNeighbor iterator does not go off the list 
-	while (count != this->getNumberOfNeighbors()) {
-		it++;
-		count++;
-	}
-
-	if (it == currentNeighbor) {
-		return vertexLabel;
-	}
-
-
-	return currentNeighbor->first;
-}
-
-/**returns the endVertex value for the edge*/
-string Vertex::getEndVertex()
-{
-	if (this->getNumberOfNeighbors() == 0) {
-		return this->getLabel();
-		}
-	
-	currentNeighbor--;
-	string endVertex = currentNeighbor->first;
-	currentNeighbor++;
-	return endVertex;
-}
\ No newline at end of file
+// the weight types listed in graph.cpp
+template class BasicVertex<int>;
+template class BasicVertex<uint16_t>;
+template class BasicVertex<uint32_t>;
+template class BasicVertex<int64_t>;
+template class BasicVertex<float>;
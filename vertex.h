@@ -3,95 +3,201 @@
 * Each vertex has a unique label
 * Can be connected to other vertices via weighted edges
 * Cannot be connected to itself
-* Used by depth-first search and breadth-first search
-* to keep track of if it has been visited or not
 */
 
 #ifndef VERTEX_H
 #define VERTEX_H
 
+#include <cstddef>
 #include <functional>
 #include <map>
+#include <memory>
+#include <memory_resource>
 #include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
 
-#include "edge.h"
+#include "labelpool.h"
+#include "weighttraits.h"
 
-class Vertex {
+/** Weight is the type of the edge weights, see weighttraits.h */
+template <typename Weight>
+class BasicVertex {
 public:
-	/** Creates an unvisited vertex, gives it a label, and clears its
+	/** orders label handles alphabetically by their text
+	the same handle is the same label, so equal labels are found
+	without comparing text */
+	struct ByLabel {
+		const LabelPool* labels;
+
+		bool operator()(LabelPool::Label left, LabelPool::Label right) const
+		{
+			return left != right && labels->view(left) < labels->view(right);
+		}
+	};
+
+	/** adjacency list, edge weight by neighbor label in alphabetical
+	order */
+	typedef std::pmr::map<LabelPool::Label, Weight, ByLabel> AdjacencyList;
+
+	/** returned by getEdgeWeight if the edge does not exist */
+	static constexpr Weight NO_EDGE = WeightTraits<Weight>::NO_EDGE;
+
+	/** end vertex label handle and weight of an edge to add */
+	typedef std::pair<LabelPool::Label, Weight> Connection;
+
+	/** Creates a vertex, gives it a label, and clears its
 	adjacency list.
+	The vertex keeps its own LabelPool for its label and the labels
+	of its neighbors.
 	NOTE: A vertex must have a unique label that cannot be changed. */
-	explicit Vertex(std::string label);
+	explicit BasicVertex(std::string_view label,
+		std::pmr::memory_resource* memory = std::pmr::get_default_resource());
+
+	/** Creates a vertex with a label already in labels, which the
+	vertex shares with the graph.
+	The adjacency list nodes are allocated from memory, the graph's
+	arena if it has one. */
+	BasicVertex(LabelPool::Label label, LabelPool& labels,
+		std::pmr::memory_resource* memory);
 
 	/** @return  The label of this vertex. */
 	std::string getLabel() const;
 
-	/** Marks this vertex as visited. */
-	void visit();
-
-	/** Marks this vertex as not visited. */
-	void unvisit();
-
-	/** Returns the visited status of this vertex.
-	@return  True if the vertex has been visited, otherwise
-	returns false/ */
-	bool isVisited() const;
+	/** @return  The handle of the label of this vertex. */
+	LabelPool::Label getLabelId() const;
 
 	/** Adds an edge between this vertex and the given vertex.
 	Cannot have multiple connections to the same endVertex
 	Cannot connect back to itself
 	@return  True if the connection is successful. */
-	bool connect(const std::string& endVertex, const int edgeWeight = 0);
+	bool connect(std::string_view endVertex, const Weight edgeWeight = 0);
+
+	/** Adds an edge to the vertex whose label has handle endVertex
+	in the pool this vertex uses.
+	@return  True if the connection is successful. */
+	bool connect(LabelPool::Label endVertex, const Weight edgeWeight = 0);
+
+	/** Adds an edge for each of first .. last - 1, which are in
+	alphabetical order of their end vertex with no end twice, so each
+	edge goes in next to the one before. An existing edge keeps its
+	weight. The connections added are moved to the front of the range,
+	in order.
+	@return  The number of edges added. */
+	size_t connectSorted(
+		typename std::vector<Connection>::iterator first,
+		typename std::vector<Connection>::iterator last);
 
 	/** Removes the edge between this vertex and the given one.
 	@return  True if the removal is successful. */
-	bool disconnect(const std::string& endVertex);
+	bool disconnect(std::string_view endVertex);
 
 	/** Gets the weight of the edge between this vertex and the 
 	given vertex. @return  The edge weight.
 	This value is zero for an unweighted graph and
-	is negative if the .edge does not exist */
-	int getEdgeWeight(const std::string& endVertex = 0);
-
-	/** Calculates how many neighbors this vertex has.
-	@return  The number of the vertex's neighbors. */
-	int getNumberOfNeighbors();
-
-	/** Sets current neighbor to first in adjacency list. */
-	void resetNeighbor();
-
-	/** Gets this vertex's next neighbor in the adjacency list.
-	Neighbors are automatically sorted alphabetically via map
-	Returns the vertex label if there are no more neighbors
-	@return  The label of the vertex's next neighbor. */
-	std::string getNextNeighbor();
+	is NO_EDGE if the .edge does not exist */
+	Weight getEdgeWeight(std::string_view endVertex) const;
+
+	/** @return  The number of the vertex's neighbors. */
+	int getNumberOfNeighbors() const;
+
+	/** one neighbor, the end of an edge leaving this vertex */
+	struct Neighbor {
+		std::string_view label;
+		Weight weight;
+
+		/** handle of label in the pool the vertex uses */
+		LabelPool::Label id;
+	};
+
+	/** walks the neighbors in alphabetical order, each step is O(1) */
+	class NeighborIterator {
+	public:
+		NeighborIterator(typename AdjacencyList::const_iterator position,
+			const LabelPool* labels)
+			: it(position), labels(labels) {}
+
+		Neighbor operator*() const
+		{
+			return Neighbor{ labels->view(it->first), it->second, it->first };
+		}
+
+		NeighborIterator& operator++()
+		{
+			++it;
+			return *this;
+		}
+
+		bool operator==(const NeighborIterator& other) const
+		{
+			return it == other.it;
+		}
+
+		bool operator!=(const NeighborIterator& other) const
+		{
+			return it != other.it;
+		}
+
+	private:
+		typename AdjacencyList::const_iterator it;
+		const LabelPool* labels;
+	};
+
+	/** the neighbors of a vertex, for use in a range-based for loop */
+	class NeighborRange {
+	public:
+		NeighborRange(const AdjacencyList& edges, const LabelPool* labels)
+			: adjacency(edges), labels(labels) {}
+
+		NeighborIterator begin() const
+		{
+			return NeighborIterator(adjacency.begin(), labels);
+		}
+
+		NeighborIterator end() const
+		{
+			return NeighborIterator(adjacency.end(), labels);
+		}
+
+		size_t size() const { return adjacency.size(); }
+
+		bool empty() const { return adjacency.empty(); }
+
+	private:
+		const AdjacencyList& adjacency;
+		const LabelPool* labels;
+	};
+
+	/** Neighbors are automatically sorted alphabetically via map
+	for (Vertex::Neighbor n : v.neighbors()) gives n.label, n.weight
+	@return  The neighbors of this vertex. */
+	NeighborRange neighbors() const;
 
 	/** Sees whether this vertex is equal to another one.
 	Two vertices are equal if they have the same label. */
-	bool operator==(const Vertex& rightHandItem) const;
+	bool operator==(const BasicVertex& rightHandItem) const;
 
 	/** Sees whether this vertex is < another one.
 	Compares vertexLabel. */
-	bool operator<(const Vertex& rightHandItem) const;
+	bool operator<(const BasicVertex& rightHandItem) const;
 
-	/**Used in situations where getNextNeighbor will not work*/
-	string getCurrentNeighbor();
+private:
+	/** pool of a vertex made on its own, nullptr if the pool belongs
+	to a graph */
+	std::unique_ptr<LabelPool> ownLabels;
 
-	/**returns the endVertex value of an edge*/
-	string getEndVertex();
+	/** where the label and the neighbor labels are interned */
+	LabelPool* labels;
 
-private:
 	/** the unique label for the vertex */
-	std::string vertexLabel;
-
-	/** True if the vertex is visited */
-	bool visited{ false };
+	LabelPool::Label vertexLabel;
 
 	/** adjacencyList as an ordered map, in alphabetical order */
-	std::map<std::string, Edge, std::less<std::string>> adjacencyList;
+	AdjacencyList adjacencyList;
+};  // end BasicVertex
 
-	/** iterator showing which neighbor we are currently at */
-	std::map<std::string, Edge>::iterator currentNeighbor;
-};
+/** vertex of the default Graph */
+typedef BasicVertex<int> Vertex;
 
 #endif  // VERTEX_H
@@ -0,0 +1,70 @@
+/**
+* How the edge weights of a graph are spread
+* Graph keeps a WeightProfile up to date as edges are added and hands
+* it to its CSR snapshot, which picks the queue of its shortest-path
+* searches from it. When every weight is the same, or every weight is
+* 0 or 1, Dijkstra does not need a heap.
+*/
+
+#ifndef WEIGHTPROFILE_H
+#define WEIGHTPROFILE_H
+
+#include <cstdint>
+
+/** Weight is the type of the edge weights, see weighttraits.h */
+template <typename Weight>
+class WeightProfile {
+public:
+	/** constructor, no edges counted */
+	WeightProfile() = default;
+
+	/** constructor, the counts and bounds of a profile saved before */
+	WeightProfile(uint64_t numEdges, uint64_t numZero, uint64_t numOne,
+		Weight minWeight, Weight maxWeight)
+		: numEdges(numEdges), numZero(numZero), numOne(numOne),
+		minWeight(minWeight), maxWeight(maxWeight) {}
+
+	/** count one more edge of the given weight */
+	void add(Weight weight)
+	{
+		if (numEdges == 0 || weight < minWeight) {
+			minWeight = weight;
+		}
+		if (numEdges == 0 || weight > maxWeight) {
+			maxWeight = weight;
+		}
+		++numEdges;
+		numZero += weight == 0;
+		numOne += weight == 1;
+	}
+
+	/** return number of edges counted */
+	uint64_t getNumEdges() const { return numEdges; }
+
+	/** return number of edges of weight 0 */
+	uint64_t getNumZero() const { return numZero; }
+
+	/** return number of edges of weight 1 */
+	uint64_t getNumOne() const { return numOne; }
+
+	/** return the smallest weight, 0 if there are no edges */
+	Weight getMinWeight() const { return minWeight; }
+
+	/** return the largest weight, 0 if there are no edges */
+	Weight getMaxWeight() const { return maxWeight; }
+
+	/** True if every edge has the same weight, or there are none */
+	bool isUniform() const { return minWeight == maxWeight; }
+
+	/** True if every edge has weight 0 or 1, or there are none */
+	bool isZeroOne() const { return numZero + numOne == numEdges; }
+
+private:
+	uint64_t numEdges{ 0 };
+	uint64_t numZero{ 0 };
+	uint64_t numOne{ 0 };
+	Weight minWeight{ 0 };
+	Weight maxWeight{ 0 };
+};  // end WeightProfile
+
+#endif  // WEIGHTPROFILE_H
@@ -0,0 +1,77 @@
+/**
+* Edge weight types a graph can be built with
+* WeightTraits<Weight> gives the type path costs are added up in, the
+* cost of a vertex that cannot be reached and an addition that stops at
+* that cost instead of overflowing.
+* Narrow weights add up in a wider type. int keeps int costs, so the
+* default Graph still returns INT_MAX for unreachable vertices.
+* float adds up in float and overflows to infinity on its own.
+* Graphs are instantiated for the weights and ids listed in graph.cpp.
+*/
+
+#ifndef WEIGHTTRAITS_H
+#define WEIGHTTRAITS_H
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+/** shared part of every WeightTraits */
+template <typename WeightType, typename CostType>
+struct BasicWeightTraits {
+	typedef WeightType Weight;
+	typedef CostType Cost;
+
+	/** cost of a vertex that cannot be reached, also the cost of a
+	path too long for Cost */
+	static constexpr Cost UNREACHABLE =
+		std::numeric_limits<Cost>::has_infinity ?
+		std::numeric_limits<Cost>::infinity() :
+		std::numeric_limits<Cost>::max();
+
+	/** weight returned for an edge that does not exist */
+	static constexpr Weight NO_EDGE =
+		std::numeric_limits<Weight>::has_infinity ?
+		std::numeric_limits<Weight>::infinity() :
+		std::numeric_limits<Weight>::max();
+
+	/** return false for a NaN or infinite weight, which no edge may
+	have: NaN breaks every comparison and infinity is NO_EDGE */
+	static bool isFinite(Weight weight)
+	{
+		return !std::is_floating_point<Weight>::value ||
+			std::isfinite(static_cast<double>(weight));
+	}
+
+	/** return cost + extra, UNREACHABLE if the sum does not fit */
+	static Cost add(Cost cost, Cost extra)
+	{
+		if (!std::is_floating_point<Cost>::value && extra > 0 &&
+			cost > UNREACHABLE - extra) {
+			return UNREACHABLE;
+		}
+		return cost + extra;
+	}
+};
+
+/** only the weight types below can be used */
+template <typename Weight>
+struct WeightTraits;
+
+template <>
+struct WeightTraits<int> : BasicWeightTraits<int, int> {};
+
+template <>
+struct WeightTraits<uint16_t> : BasicWeightTraits<uint16_t, uint32_t> {};
+
+template <>
+struct WeightTraits<uint32_t> : BasicWeightTraits<uint32_t, uint64_t> {};
+
+template <>
+struct WeightTraits<int64_t> : BasicWeightTraits<int64_t, int64_t> {};
+
+template <>
+struct WeightTraits<float> : BasicWeightTraits<float, float> {};
+
+#endif  // WEIGHTTRAITS_H